@@ -5,41 +5,210 @@
 #include <fstream>
 #include <algorithm>
 #include <stdexcept>
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <bitset>
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cerrno>
+#include <charconv>
+#include <exception>
+#include <type_traits>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Дескриптор интернированного имени: одинаковые имена получают один id
+enum class NameId : uint32_t {};
+
+// Пул интернированных строк. Байты лежат в блоках арены, которые никогда
+// не перемещаются, поэтому выданные string_view действительны до конца программы.
+// Обратный поиск — таблица с открытой адресацией (0 — пустая ячейка).
+class NameTable {
+private:
+    static constexpr size_t blockCapacity_ = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t blockUsed_ = 0;
+    size_t blockSize_ = 0;
+    std::vector<const char*> starts_;
+    std::vector<uint32_t> lengths_;
+    std::vector<size_t> hashes_;
+    std::vector<uint32_t> slots_;
+
+    const char* store(std::string_view name) {
+        // Пустому имени байты не нужны, а блоков может ещё не быть
+        if (name.empty()) {
+            return "";
+        }
+        if (name.size() > blockSize_ - blockUsed_) {
+            blockSize_ = std::max(blockCapacity_, name.size());
+            blocks_.emplace_back(new char[blockSize_]);
+            blockUsed_ = 0;
+        }
+        char* place = blocks_.back().get() + blockUsed_;
+        std::memcpy(place, name.data(), name.size());
+        blockUsed_ += name.size();
+        return place;
+    }
+
+    void growSlots(size_t capacity) {
+        slots_.assign(capacity, 0);
+        size_t mask = capacity - 1;
+        for (uint32_t id = 0; id < hashes_.size(); ++id) {
+            size_t i = hashes_[id] & mask;
+            while (slots_[i] != 0) i = (i + 1) & mask;
+            slots_[i] = id + 1;
+        }
+    }
+
+    // Ячейка с этим именем либо пустая ячейка, куда его можно вставить
+    size_t slotFor(std::string_view name, size_t hash) const {
+        size_t mask = slots_.size() - 1;
+        size_t i = hash & mask;
+        while (slots_[i] != 0) {
+            uint32_t id = slots_[i] - 1;
+            if (hashes_[id] == hash && std::string_view(starts_[id], lengths_[id]) == name) {
+                break;
+            }
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+public:
+    std::string_view view(NameId id) const {
+        auto index = static_cast<uint32_t>(id);
+        return std::string_view(starts_[index], lengths_[index]);
+    }
+
+    static size_t hashOf(std::string_view name) { return std::hash<std::string_view>{}(name); }
+
+    NameId intern(std::string_view name) {
+        return intern(name, hashOf(name));
+    }
+
+    // Вставка с заранее посчитанным hashOf(name) (хеши считает параллельный загрузчик)
+    NameId intern(std::string_view name, size_t hash) {
+        if ((hashes_.size() + 1) * 2 > slots_.size()) {
+            growSlots(slots_.empty() ? 64 : slots_.size() * 2);
+        }
+        size_t i = slotFor(name, hash);
+        if (slots_[i] != 0) {
+            return static_cast<NameId>(slots_[i] - 1);
+        }
+        uint32_t id = static_cast<uint32_t>(hashes_.size());
+        starts_.push_back(store(name));
+        lengths_.push_back(static_cast<uint32_t>(name.size()));
+        hashes_.push_back(hash);
+        slots_[i] = id + 1;
+        return static_cast<NameId>(id);
+    }
+
+    // Место под count новых имён без перестроения таблицы
+    void reserve(size_t count) {
+        size_t total = hashes_.size() + count;
+        size_t capacity = std::max<size_t>(slots_.size(), 64);
+        while (total * 2 > capacity) capacity *= 2;
+        if (capacity > slots_.size()) growSlots(capacity);
+        starts_.reserve(total);
+        lengths_.reserve(total);
+        hashes_.reserve(total);
+    }
+
+    // Поиск без вставки
+    bool find(std::string_view name, NameId& id) const {
+        if (slots_.empty()) return false;
+        size_t i = slotFor(name, hashOf(name));
+        if (slots_[i] == 0) return false;
+        id = static_cast<NameId>(slots_[i] - 1);
+        return true;
+    }
+};
+
+// Общий пул имён пользователей и ресурсов
+NameTable& namePool() {
+    static NameTable pool;
+    return pool;
+}
+
+template <typename T>
+class AccessControlSystem;
 
 // Базовый класс User
 class User {
 protected:
-    std::string name_;
+    NameId name_;
     int id_;
     int accessLevel_;
 
 public:
-    User(const std::string& name, int id, int accessLevel) {
+    User(std::string_view name, int id, int accessLevel) {
         if (name.empty()) throw std::invalid_argument("Name cannot be empty");
         if (accessLevel < 0) throw std::invalid_argument("Access level cannot be negative");
-        name_ = name;
+        name_ = namePool().intern(name);
         id_ = id;
         accessLevel_ = accessLevel;
     }
 
+    // Для загрузчика: имя уже интернировано
+    User(NameId name, int id, int accessLevel) : name_(name), id_(id), accessLevel_(accessLevel) {
+        if (namePool().view(name).empty()) throw std::invalid_argument("Name cannot be empty");
+        if (accessLevel < 0) throw std::invalid_argument("Access level cannot be negative");
+    }
+
+    // Тег записи в файле ("User: имя,id,уровень")
+    static constexpr std::string_view recordTag = "User";
+
+    // Тег и дополнительное поле записи для сохранения (у User поля нет)
+    virtual std::string_view typeTag() const { return recordTag; }
+    virtual std::string_view typeDetail() const { return {}; }
+
     // Геттеры
-    std::string getName() const { return name_; }
+    std::string_view getName() const { return namePool().view(name_); }
+    NameId getNameId() const { return name_; }
     int getId() const { return id_; }
     int getAccessLevel() const { return accessLevel_; }
 
-    // Сеттеры
-    void setName(const std::string& name) {
+private:
+    // Имя и уровень меняются только через AccessControlSystem::renameUser и
+    // setUserAccessLevel, иначе индексы по имени и уровню разошлись бы с объектом
+    template <typename T>
+    friend class AccessControlSystem;
+
+    void setName(std::string_view name) {
         if (name.empty()) throw std::invalid_argument("Name cannot be empty");
-        name_ = name;
+        name_ = namePool().intern(name);
     }
+
     void setAccessLevel(int accessLevel) {
         if (accessLevel < 0) throw std::invalid_argument("Access level cannot be negative");
         accessLevel_ = accessLevel;
     }
 
+public:
+
     // Виртуальный метод для полиморфизма
     virtual void displayInfo() const {
-        std::cout << "User: " << name_ << ", ID: " << id_ << ", Access Level: " << accessLevel_ << std::endl;
+        std::cout << "User: " << getName() << ", ID: " << id_ << ", Access Level: " << accessLevel_ << std::endl;
     }
 
     virtual ~User() = default;
@@ -51,13 +220,25 @@ private:
     std::string group_;
 
 public:
-    Student(const std::string& name, int id, int accessLevel, const std::string& group)
+    Student(std::string_view name, int id, int accessLevel, const std::string& group)
         : User(name, id, accessLevel), group_(group) {
         if (group.empty()) throw std::invalid_argument("Group cannot be empty");
     }
 
+    Student(NameId name, int id, int accessLevel, std::string_view group)
+        : User(name, id, accessLevel), group_(group) {
+        if (group.empty()) throw std::invalid_argument("Group cannot be empty");
+    }
+
+    static constexpr std::string_view recordTag = "Student";
+
+    const std::string& getGroup() const { return group_; }
+
+    std::string_view typeTag() const override { return recordTag; }
+    std::string_view typeDetail() const override { return group_; }
+
     void displayInfo() const override {
-        std::cout << "Student: " << name_ << ", ID: " << id_ << ", Access Level: " << accessLevel_
+        std::cout << "Student: " << getName() << ", ID: " << id_ << ", Access Level: " << accessLevel_
             << ", Group: " << group_ << std::endl;
     }
 };
@@ -68,13 +249,25 @@ private:
     std::string department_;
 
 public:
-    Teacher(const std::string& name, int id, int accessLevel, const std::string& department)
+    Teacher(std::string_view name, int id, int accessLevel, const std::string& department)
+        : User(name, id, accessLevel), department_(department) {
+        if (department.empty()) throw std::invalid_argument("Department cannot be empty");
+    }
+
+    Teacher(NameId name, int id, int accessLevel, std::string_view department)
         : User(name, id, accessLevel), department_(department) {
         if (department.empty()) throw std::invalid_argument("Department cannot be empty");
     }
 
+    static constexpr std::string_view recordTag = "Teacher";
+
+    const std::string& getDepartment() const { return department_; }
+
+    std::string_view typeTag() const override { return recordTag; }
+    std::string_view typeDetail() const override { return department_; }
+
     void displayInfo() const override {
-        std::cout << "Teacher: " << name_ << ", ID: " << id_ << ", Access Level: " << accessLevel_
+        std::cout << "Teacher: " << getName() << ", ID: " << id_ << ", Access Level: " << accessLevel_
             << ", Department: " << department_ << std::endl;
     }
 };
@@ -85,39 +278,714 @@ private:
     std::string role_;
 
 public:
-    Administrator(const std::string& name, int id, int accessLevel, const std::string& role)
+    Administrator(std::string_view name, int id, int accessLevel, const std::string& role)
+        : User(name, id, accessLevel), role_(role) {
+        if (role.empty()) throw std::invalid_argument("Role cannot be empty");
+    }
+
+    Administrator(NameId name, int id, int accessLevel, std::string_view role)
         : User(name, id, accessLevel), role_(role) {
         if (role.empty()) throw std::invalid_argument("Role cannot be empty");
     }
 
+    static constexpr std::string_view recordTag = "Administrator";
+
+    const std::string& getRole() const { return role_; }
+
+    std::string_view typeTag() const override { return recordTag; }
+    std::string_view typeDetail() const override { return role_; }
+
     void displayInfo() const override {
-        std::cout << "Administrator: " << name_ << ", ID: " << id_ << ", Access Level: " << accessLevel_
+        std::cout << "Administrator: " << getName() << ", ID: " << id_ << ", Access Level: " << accessLevel_
             << ", Role: " << role_ << std::endl;
     }
 };
 
+// Реестр типов пользователей для файлового формата: тег записи -> фабрика.
+// Загрузчик находит тип один раз при разборе строки и вызывает фабрику
+// через указатель на функцию, без виртуальных вызовов.
+class UserTypeRegistry {
+public:
+    using Factory = std::unique_ptr<User> (*)(NameId name, int id, int accessLevel, std::string_view detail);
+
+private:
+    struct Entry {
+        std::string_view tag;
+        Factory create;
+    };
+    std::vector<Entry> types_;
+
+    template <typename T>
+    static std::unique_ptr<User> create(NameId name, int id, int accessLevel, std::string_view detail) {
+        if constexpr (std::is_same_v<T, User>) {
+            return std::make_unique<User>(name, id, accessLevel);
+        }
+        else {
+            return std::make_unique<T>(name, id, accessLevel, detail);
+        }
+    }
+
+public:
+    // Регистрация типа с тегом T::recordTag (до загрузки файлов)
+    template <typename T>
+    void add() {
+        static_assert(std::is_base_of_v<User, T>, "Registered type must derive from User");
+        types_.push_back({ T::recordTag, &create<T> });
+    }
+
+    // Индекс типа по тегу; false, если тег не зарегистрирован
+    bool find(std::string_view tag, uint8_t& index) const {
+        for (size_t i = 0; i < types_.size(); ++i) {
+            if (types_[i].tag == tag) {
+                index = static_cast<uint8_t>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Factory factory(uint8_t index) const { return types_[index].create; }
+};
+
+UserTypeRegistry& userTypes() {
+    static UserTypeRegistry registry = [] {
+        UserTypeRegistry r;
+        r.add<User>();
+        r.add<Student>();
+        r.add<Teacher>();
+        r.add<Administrator>();
+        return r;
+    }();
+    return registry;
+}
+
 // Класс Resource
 class Resource {
 private:
-    std::string name_;
+    NameId name_;
     int requiredAccessLevel_;
 
 public:
-    Resource(const std::string& name, int requiredAccessLevel) {
+    Resource(std::string_view name, int requiredAccessLevel) {
         if (name.empty()) throw std::invalid_argument("Resource name cannot be empty");
         if (requiredAccessLevel < 0) throw std::invalid_argument("Required access level cannot be negative");
-        name_ = name;
+        name_ = namePool().intern(name);
         requiredAccessLevel_ = requiredAccessLevel;
     }
 
+    // Для загрузчика: имя уже интернировано
+    Resource(NameId name, int requiredAccessLevel) : name_(name), requiredAccessLevel_(requiredAccessLevel) {
+        if (namePool().view(name).empty()) throw std::invalid_argument("Resource name cannot be empty");
+        if (requiredAccessLevel < 0) throw std::invalid_argument("Required access level cannot be negative");
+    }
+
     bool checkAccess(const User& user) const {
         return user.getAccessLevel() >= requiredAccessLevel_;
     }
 
-    std::string getName() const { return name_; }
+    std::string_view getName() const { return namePool().view(name_); }
+    NameId getNameId() const { return name_; }
     int getRequiredAccessLevel() const { return requiredAccessLevel_; }
 };
 
+// Хеш для целочисленных ключей (перемешивание Фибоначчи)
+struct IdHash {
+    size_t operator()(int id) const {
+        uint64_t x = static_cast<uint32_t>(id) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+    size_t operator()(NameId id) const {
+        return (*this)(static_cast<int>(id));
+    }
+};
+
+// Индекс с открытой адресацией (линейное пробирование).
+// Хранит только указатели на объекты, ключ извлекается функтором KeyOf,
+// поэтому копии ключей в индексе не хранятся.
+template <typename V, typename Key, typename KeyOf, typename Hash = std::hash<Key>>
+class FlatIndex {
+private:
+    std::vector<V*> slots_;
+    size_t size_ = 0;
+
+    size_t slotFor(const Key& key) const {
+        size_t mask = slots_.size() - 1;
+        size_t i = Hash{}(key) & mask;
+        while (slots_[i] != nullptr && !(KeyOf{}(slots_[i]) == key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<V*> old = std::move(slots_);
+        slots_.assign(capacity, nullptr);
+        for (V* value : old) {
+            if (value != nullptr) {
+                slots_[slotFor(KeyOf{}(value))] = value;
+            }
+        }
+    }
+
+public:
+    void clear() {
+        slots_.clear();
+        size_ = 0;
+    }
+
+    // Место под count элементов без перестроений
+    void reserve(size_t count) {
+        size_t capacity = 16;
+        while (capacity < count * 2) capacity *= 2;
+        if (capacity > slots_.size()) rehash(capacity);
+    }
+
+    // Вставка; при совпадении ключа остаётся первый добавленный объект
+    bool insert(V* value) {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        size_t i = slotFor(KeyOf{}(value));
+        if (slots_[i] != nullptr) return false;
+        slots_[i] = value;
+        ++size_;
+        return true;
+    }
+
+    V* find(const Key& key) const {
+        if (slots_.empty()) return nullptr;
+        return slots_[slotFor(key)];
+    }
+
+    // Удаление объекта (ключ читается из него, поэтому до изменения ключа).
+    // Следующие элементы сдвигаются назад, чтобы цепочки пробирования не рвались
+    bool erase(const V* value) {
+        if (slots_.empty()) return false;
+        size_t mask = slots_.size() - 1;
+        size_t hole = slotFor(KeyOf{}(value));
+        if (slots_[hole] != value) return false;
+        slots_[hole] = nullptr;
+        --size_;
+        for (size_t i = (hole + 1) & mask; slots_[i] != nullptr; i = (i + 1) & mask) {
+            size_t home = Hash{}(KeyOf{}(slots_[i])) & mask;
+            // Элемент можно перенести в дыру, если его домашняя ячейка не лежит между ними
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots_[hole] = slots_[i];
+                slots_[i] = nullptr;
+                hole = i;
+            }
+        }
+        return true;
+    }
+};
+
+// Индекс id -> позиция в массиве пользователей (открытая адресация).
+// Ключи и позиции лежат в самой таблице, поэтому поиск не обращается
+// к объектам пользователей.
+class IdPositionIndex {
+private:
+    struct Slot {
+        int id;
+        uint32_t position;
+    };
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+
+    size_t slotFor(int id) const {
+        size_t mask = slots_.size() - 1;
+        size_t i = IdHash{}(id) & mask;
+        while (slots_[i].position != npos && slots_[i].id != id) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old = std::move(slots_);
+        slots_.assign(capacity, Slot{ 0, npos });
+        for (const Slot& slot : old) {
+            if (slot.position != npos) {
+                slots_[slotFor(slot.id)] = slot;
+            }
+        }
+    }
+
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    void clear() {
+        slots_.clear();
+        size_ = 0;
+    }
+
+    // Место под count элементов без перестроений
+    void reserve(size_t count) {
+        size_t capacity = 16;
+        while (capacity < count * 2) capacity *= 2;
+        if (capacity > slots_.size()) rehash(capacity);
+    }
+
+    // Вставка; при совпадении id остаётся первая позиция
+    bool insert(int id, uint32_t position) {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        size_t i = slotFor(id);
+        if (slots_[i].position != npos) return false;
+        slots_[i] = Slot{ id, position };
+        ++size_;
+        return true;
+    }
+
+    // Позиция пользователя с данным id или npos
+    uint32_t find(int id) const {
+        if (slots_.empty()) return npos;
+        return slots_[slotFor(id)].position;
+    }
+
+    // Перенос уже добавленного id на новую позицию
+    void move(int id, uint32_t position) {
+        Slot& slot = slots_[slotFor(id)];
+        assert(slot.position != npos);
+        slot.position = position;
+    }
+};
+
+// Индекс пользователей по уровню доступа: отсортированные блоки ключей
+// (уровень, id) и параллельные им указатели. Вставка и удаление трогают
+// один блок (не больше blockCapacity_ элементов), запрос диапазона —
+// двоичный поиск и проход по найденным элементам подряд.
+class LevelIndex {
+private:
+    static constexpr size_t blockCapacity_ = 512;
+
+    struct Block {
+        std::vector<uint64_t> keys;
+        std::vector<User*> users;
+    };
+    std::vector<Block> blocks_;
+
+    // Уровень в старших 32 битах, id (со сдвигом знака) в младших:
+    // порядок ключей — порядок по уровню, затем по id
+    static uint64_t keyOf(int level, int id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(level)) << 32) | (static_cast<uint32_t>(id) ^ 0x80000000u);
+    }
+
+    // Первый блок, последний ключ которого не меньше key
+    size_t blockFor(uint64_t key) const {
+        auto it = std::partition_point(blocks_.begin(), blocks_.end(),
+            [key](const Block& block) { return block.keys.back() < key; });
+        return static_cast<size_t>(it - blocks_.begin());
+    }
+
+public:
+    void clear() {
+        blocks_.clear();
+    }
+
+    // Построение заново по всем пользователям (после загрузки)
+    void assign(const std::vector<std::unique_ptr<User>>& users) {
+        std::vector<std::pair<uint64_t, User*>> entries;
+        entries.reserve(users.size());
+        for (const auto& user : users) {
+            entries.emplace_back(keyOf(user->getAccessLevel(), user->getId()), user.get());
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        // Блоки заполняются на три четверти, чтобы вставки не делили их сразу
+        blocks_.clear();
+        for (size_t i = 0; i < entries.size(); i += blockCapacity_ * 3 / 4) {
+            Block block;
+            size_t end = std::min(entries.size(), i + blockCapacity_ * 3 / 4);
+            block.keys.reserve(blockCapacity_);
+            block.users.reserve(blockCapacity_);
+            for (size_t j = i; j < end; ++j) {
+                block.keys.push_back(entries[j].first);
+                block.users.push_back(entries[j].second);
+            }
+            blocks_.push_back(std::move(block));
+        }
+    }
+
+    void insert(User* user) {
+        uint64_t key = keyOf(user->getAccessLevel(), user->getId());
+        if (blocks_.empty()) {
+            blocks_.push_back(Block{ { key }, { user } });
+            return;
+        }
+        size_t b = std::min(blockFor(key), blocks_.size() - 1);
+        Block& block = blocks_[b];
+        size_t pos = static_cast<size_t>(std::upper_bound(block.keys.begin(), block.keys.end(), key) - block.keys.begin());
+        block.keys.insert(block.keys.begin() + pos, key);
+        block.users.insert(block.users.begin() + pos, user);
+
+        if (block.keys.size() > blockCapacity_) {
+            size_t half = block.keys.size() / 2;
+            Block upper;
+            upper.keys.assign(block.keys.begin() + half, block.keys.end());
+            upper.users.assign(block.users.begin() + half, block.users.end());
+            block.keys.resize(half);
+            block.users.resize(half);
+            blocks_.insert(blocks_.begin() + b + 1, std::move(upper));
+        }
+    }
+
+    // Удаление пользователя, записанного с уровнем level
+    bool erase(const User* user, int level) {
+        uint64_t key = keyOf(level, user->getId());
+        for (size_t b = blockFor(key); b < blocks_.size(); ++b) {
+            Block& block = blocks_[b];
+            auto it = std::lower_bound(block.keys.begin(), block.keys.end(), key);
+            for (; it != block.keys.end() && *it == key; ++it) {
+                size_t pos = static_cast<size_t>(it - block.keys.begin());
+                if (block.users[pos] == user) {
+                    block.keys.erase(it);
+                    block.users.erase(block.users.begin() + pos);
+                    if (block.keys.empty()) blocks_.erase(blocks_.begin() + b);
+                    return true;
+                }
+            }
+            if (it != block.keys.end()) break;
+        }
+        return false;
+    }
+
+    // Обход пользователей с уровнем в [lo, hi] по возрастанию уровня
+    template <typename F>
+    void forEachInRange(int lo, int hi, F&& visit) const {
+        lo = std::max(lo, 0);
+        if (hi < lo) return;
+        uint64_t first = keyOf(lo, INT_MIN);
+        uint64_t last = keyOf(hi, INT_MAX);
+        for (size_t b = blockFor(first); b < blocks_.size(); ++b) {
+            const Block& block = blocks_[b];
+            size_t pos = static_cast<size_t>(std::lower_bound(block.keys.begin(), block.keys.end(), first) - block.keys.begin());
+            for (; pos < block.keys.size(); ++pos) {
+                if (block.keys[pos] > last) return;
+                visit(block.users[pos]);
+            }
+        }
+    }
+};
+
+// Надёжная запись файла: данные пишутся во временный файл рядом с целевым,
+// сбрасываются на диск и переименовываются поверх целевого. После сбоя
+// на диске остаётся либо старое, либо новое содержимое целиком.
+// В POSIX дополнительно сбрасывается каталог, чтобы сохранилось само переименование.
+#ifdef _WIN32
+void writeFileAtomic(const std::string& filename, std::string_view data) {
+    std::string temp = filename + ".tmp";
+    HANDLE handle = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) throw std::runtime_error("Unable to open file for writing");
+
+    bool ok = true;
+    while (ok && !data.empty()) {
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(data.size(), 1u << 30));
+        DWORD written = 0;
+        ok = WriteFile(handle, data.data(), chunk, &written, nullptr) != 0;
+        data.remove_prefix(written);
+    }
+    ok = ok && FlushFileBuffers(handle) != 0;
+    CloseHandle(handle);
+    if (!ok || !MoveFileExA(temp.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileA(temp.c_str());
+        throw std::runtime_error("Unable to write file: " + filename);
+    }
+}
+#else
+void writeFileAtomic(const std::string& filename, std::string_view data) {
+    std::string temp = filename + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::runtime_error("Unable to open file for writing");
+
+    bool ok = true;
+    while (ok && !data.empty()) {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            ok = errno == EINTR;
+            continue;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || ::rename(temp.c_str(), filename.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        throw std::runtime_error("Unable to write file: " + filename);
+    }
+
+    size_t slash = filename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : filename.substr(0, slash);
+    int dir = ::open(directory.c_str(), O_RDONLY);
+    if (dir >= 0) {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+#endif
+
+// Фоновая запись файлов: вызывающий поток передаёт функцию, которая
+// собирает текст из его копии данных, поэтому ни форматирование, ни диск
+// его не задерживают. Записи выполняются по порядку; ещё не начатая запись
+// в тот же файл заменяется более новой. Поток запускается при первой записи,
+// первая ошибка передаётся следующему вызову wait().
+class BackgroundSaver {
+public:
+    using Builder = std::function<std::string()>;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable work_;
+    std::condition_variable idle_;
+    std::deque<std::pair<std::string, Builder>> jobs_;
+    std::thread worker_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::string error_;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            work_.wait(lock, [&] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) return;
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            std::string failure;
+            try {
+                writeFileAtomic(job.first, job.second());
+            }
+            catch (const std::exception& e) {
+                failure = e.what();
+            }
+            lock.lock();
+            busy_ = false;
+            if (!failure.empty() && error_.empty()) error_ = std::move(failure);
+            idle_.notify_all();
+        }
+    }
+
+public:
+    BackgroundSaver() = default;
+    BackgroundSaver(const BackgroundSaver&) = delete;
+    BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+
+    // Дописывает все поставленные в очередь файлы
+    ~BackgroundSaver() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_.notify_one();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    void save(const std::string& filename, Builder build) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(),
+            [&](const auto& job) { return job.first == filename; }), jobs_.end());
+        jobs_.emplace_back(filename, std::move(build));
+        if (!worker_.joinable()) worker_ = std::thread(&BackgroundSaver::run, this);
+        work_.notify_one();
+    }
+
+    // Ожидание, пока все поставленные записи окажутся на диске;
+    // бросает первую ошибку с прошлого вызова wait()
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [&] { return jobs_.empty() && !busy_; });
+        if (!error_.empty()) {
+            std::string message = std::move(error_);
+            error_.clear();
+            throw std::runtime_error(message);
+        }
+    }
+};
+
+// Отображение всего файла в память только для чтения (пустой файл — пустой вид)
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Unable to open file for reading");
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            CloseHandle(file_);
+            throw std::runtime_error("Unable to open file for reading");
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ == 0) return;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping_) CloseHandle(mapping_);
+            CloseHandle(file_);
+            throw std::runtime_error("Unable to map file: " + filename);
+        }
+        data_ = static_cast<const char*>(view);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Unable to open file for reading");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Unable to open file for reading");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return;
+        }
+        void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) throw std::runtime_error("Unable to map file: " + filename);
+        // Файл читается один раз от начала до конца
+        ::madvise(view, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(view);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        CloseHandle(file_);
+#else
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+// Записи одного куска файла. Имена указывают в отображённый файл, их хеши
+// посчитаны при разборе; пул имён и объекты заполняются позже, в одном потоке.
+struct ParsedRecords {
+    struct UserRecord {
+        std::string_view name;
+        std::string_view detail;
+        size_t nameHash;
+        int id;
+        int accessLevel;
+        uint8_t type; // индекс в userTypes()
+    };
+    struct ResourceRecord {
+        std::string_view name;
+        size_t nameHash;
+        int requiredAccessLevel;
+    };
+
+    std::vector<UserRecord> users;
+    std::vector<ResourceRecord> resources;
+};
+
+// Целое после необязательных пробелов; pos сдвигается за число
+bool parseInt(std::string_view line, size_t& pos, int& value) {
+    while (pos < line.size() && line[pos] == ' ') ++pos;
+    auto [end, ec] = std::from_chars(line.data() + pos, line.data() + line.size(), value);
+    if (ec != std::errc()) return false;
+    pos = static_cast<size_t>(end - line.data());
+    return true;
+}
+
+// Разбор строк [begin, end). Формат:
+//   <Тег>: имя,id,уровень[,поле]   (тег из userTypes(), например Student: Jessy,1,3,CS101)
+//   Resource: имя,уровень
+// Прочие строки пропускаются
+void parseRecords(const char* begin, const char* end, ParsedRecords& out) {
+    const UserTypeRegistry& types = userTypes();
+
+    while (begin < end) {
+        auto newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        const char* lineEnd = newline ? newline : end;
+        std::string_view line(begin, static_cast<size_t>(lineEnd - begin));
+        begin = newline ? newline + 1 : end;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        size_t colon = line.find(": ");
+        if (colon == std::string_view::npos) continue;
+        std::string_view tag = line.substr(0, colon);
+        bool isResource = tag == "Resource";
+        uint8_t type = 0;
+        if (!isResource && !types.find(tag, type)) continue;
+
+        size_t start = colon + 2;
+        size_t comma = line.find(',', start);
+        int first = 0;
+        int second = 0;
+        size_t pos = comma + 1;
+        bool ok = comma != std::string_view::npos && parseInt(line, pos, first);
+        if (ok && !isResource) {
+            ok = pos < line.size() && line[pos] == ',' && parseInt(line, ++pos, second);
+        }
+        if (!ok) throw std::runtime_error("Invalid record: " + std::string(line));
+
+        std::string_view name = line.substr(start, comma - start);
+        if (isResource) {
+            out.resources.push_back({ name, NameTable::hashOf(name), first });
+        }
+        else {
+            std::string_view detail = pos < line.size() && line[pos] == ',' ? line.substr(pos + 1) : std::string_view();
+            out.users.push_back({ name, detail, NameTable::hashOf(name), first, second, type });
+        }
+    }
+}
+
+// Разбор всего файла: он делится на куски по границам строк, куски
+// разбираются параллельно, результаты идут в порядке кусков
+std::vector<ParsedRecords> parseRecordsParallel(const char* data, size_t size) {
+    constexpr size_t minChunk = 4 * 1024 * 1024;
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t chunks = std::max<size_t>(1, std::min(threads, size / minChunk));
+
+    std::vector<const char*> bounds{ data };
+    for (size_t k = 1; k < chunks; ++k) {
+        const char* from = std::max(bounds.back(), data + size * k / chunks);
+        auto newline = static_cast<const char*>(std::memchr(from, '\n', static_cast<size_t>(data + size - from)));
+        bounds.push_back(newline ? newline + 1 : data + size);
+    }
+    bounds.push_back(data + size);
+
+    std::vector<ParsedRecords> parsed(chunks);
+    std::vector<std::exception_ptr> errors(chunks);
+    auto parseChunk = [&](size_t k) {
+        try {
+            parseRecords(bounds[k], bounds[k + 1], parsed[k]);
+        }
+        catch (...) {
+            errors[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunks; ++k) {
+        workers.emplace_back(parseChunk, k);
+    }
+    parseChunk(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return parsed;
+}
+
 // Шаблонный класс AccessControlSystem
 template<typename T>
 class AccessControlSystem {
@@ -125,15 +993,138 @@ private:
     std::vector<std::unique_ptr<User>> users_;
     std::vector<std::unique_ptr<Resource>> resources_;
 
+    struct UserNameKey {
+        NameId operator()(const User* user) const { return user->getNameId(); }
+    };
+    struct ResourceNameKey {
+        NameId operator()(const Resource* resource) const { return resource->getNameId(); }
+    };
+
+    // Вторичные индексы. Объекты лежат в unique_ptr, поэтому указатели
+    // не меняются при сортировке users_; индекс по id хранит позиции и
+    // обновляется сортировкой. Имя и уровень меняются только через
+    // renameUser и setUserAccessLevel.
+    FlatIndex<User, NameId, UserNameKey, IdHash> usersByName_;
+    IdPositionIndex usersById_;
+    FlatIndex<Resource, NameId, ResourceNameKey, IdHash> resourcesByName_;
+    LevelIndex usersByLevel_;
+
+    // Уровни доступа пользователей и требуемые уровни ресурсов в непрерывных
+    // массивах (параллельны users_ и resources_) для пакетной проверки
+    std::vector<int> userLevels_;
+    std::vector<int> resourceLevels_;
+
+    // Фоновые сохранения saveToFileAsync
+    mutable BackgroundSaver saver_;
+
+    // Копия данных для сохранения. Имена и теги указывают в пул имён и
+    // статические строки, которые не перемещаются; поле подкласса копируется.
+    struct SaveSnapshot {
+        struct UserRow {
+            std::string_view tag;
+            std::string_view name;
+            std::string detail;
+            int id;
+            int accessLevel;
+        };
+        struct ResourceRow {
+            std::string_view name;
+            int requiredAccessLevel;
+        };
+
+        std::vector<UserRow> users;
+        std::vector<ResourceRow> resources;
+    };
+
+    SaveSnapshot snapshot() const {
+        SaveSnapshot copy;
+        copy.users.reserve(users_.size());
+        for (const auto& user : users_) {
+            copy.users.push_back({ user->typeTag(), user->getName(), std::string(user->typeDetail()),
+                user->getId(), user->getAccessLevel() });
+        }
+        copy.resources.reserve(resources_.size());
+        for (const auto& resource : resources_) {
+            copy.resources.push_back({ resource->getName(), resource->getRequiredAccessLevel() });
+        }
+        return copy;
+    }
+
+    static std::string format(const SaveSnapshot& copy) {
+        std::string text;
+        text.reserve((copy.users.size() + copy.resources.size()) * 32);
+        for (const auto& user : copy.users) {
+            text += user.tag;
+            text += ": ";
+            text += user.name;
+            text += "," + std::to_string(user.id) + "," + std::to_string(user.accessLevel);
+            if (!user.detail.empty()) {
+                text += ',';
+                text += user.detail;
+            }
+            text += '\n';
+        }
+        for (const auto& resource : copy.resources) {
+            text += "Resource: ";
+            text += resource.name;
+            text += "," + std::to_string(resource.requiredAccessLevel) + "\n";
+        }
+        return text;
+    }
+
+    // Индексы и столбец уровня для пользователя, только что добавленного в users_
+    void indexUser(User* user) {
+        usersByName_.insert(user);
+        usersById_.insert(user->getId(), static_cast<uint32_t>(users_.size() - 1));
+        userLevels_.push_back(user->getAccessLevel());
+    }
+
 public:
     // Добавление пользователя
     void addUser(std::unique_ptr<User> user) {
         users_.push_back(std::move(user));
+        indexUser(users_.back().get());
+        usersByLevel_.insert(users_.back().get());
+    }
+
+    // Смена уровня доступа с обновлением индекса по уровню
+    void setUserAccessLevel(int userId, int accessLevel) {
+        uint32_t position = usersById_.find(userId);
+        if (position == IdPositionIndex::npos) throw std::invalid_argument("Unknown user id: " + std::to_string(userId));
+        if (accessLevel < 0) throw std::invalid_argument("Access level cannot be negative");
+        User* user = users_[position].get();
+        usersByLevel_.erase(user, user->getAccessLevel());
+        user->setAccessLevel(accessLevel);
+        userLevels_[position] = accessLevel;
+        usersByLevel_.insert(user);
+    }
+
+    // Переименование с обновлением индекса по имени. Если под старым именем
+    // есть другой пользователь, индекс переходит к нему
+    void renameUser(int userId, std::string_view name) {
+        uint32_t position = usersById_.find(userId);
+        if (position == IdPositionIndex::npos) throw std::invalid_argument("Unknown user id: " + std::to_string(userId));
+        if (name.empty()) throw std::invalid_argument("Name cannot be empty");
+        User* user = users_[position].get();
+        NameId oldName = user->getNameId();
+        bool indexed = usersByName_.erase(user);
+        user->setName(name);
+        usersByName_.insert(user);
+        if (indexed) {
+            for (const auto& other : users_) {
+                if (other->getNameId() == oldName) {
+                    usersByName_.insert(other.get());
+                    break;
+                }
+            }
+        }
     }
 
     // Добавление ресурса
     void addResource(std::unique_ptr<Resource> resource) {
         resources_.push_back(std::move(resource));
+        resourcesByName_.insert(resources_.back().get());
+        resourceLevels_.push_back(resources_.back()->getRequiredAccessLevel());
     }
 
     // Проверка доступа
@@ -146,6 +1137,53 @@ public:
         }
     }
 
+    // Пакетная проверка доступа для пар (userIds[i], resourceIds[i]).
+    // Ресурс задаётся индексом в порядке добавления; неизвестный пользователь
+    // или ресурс означает отказ. Бит i результата — решение для пары i.
+    std::vector<uint64_t> checkAccessBatch(const std::vector<int>& userIds, const std::vector<int>& resourceIds) const {
+        if (userIds.size() != resourceIds.size()) {
+            throw std::invalid_argument("User and resource id lists must have the same length");
+        }
+        size_t count = userIds.size();
+
+        // Собираем уровни в два столбца, дальше сравниваем их без ветвлений.
+        // Уровни берутся из userLevels_, объекты пользователей не читаются.
+        // Пары с неизвестным пользователем или ресурсом отмечаются в known
+        // и запрещаются отдельно, а не подбором уровней-заглушек
+        std::vector<int> have(count);
+        std::vector<int> need(count);
+        std::vector<uint64_t> known((count + 63) / 64, 0);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t position = usersById_.find(userIds[i]);
+            int r = resourceIds[i];
+            bool userKnown = position != IdPositionIndex::npos;
+            bool resourceKnown = r >= 0 && static_cast<size_t>(r) < resourceLevels_.size();
+            have[i] = userKnown ? userLevels_[position] : 0;
+            need[i] = resourceKnown ? resourceLevels_[r] : 0;
+            known[i / 64] |= static_cast<uint64_t>(userKnown && resourceKnown) << (i % 64);
+        }
+
+        std::vector<uint64_t> decisions((count + 63) / 64, 0);
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 8 <= count; i += 8) {
+            __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(have.data() + i));
+            __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(need.data() + i));
+            // Отказ там, где need > have
+            __m256i denied = _mm256_cmpgt_epi32(n, h);
+            uint64_t bits = ~static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(denied))) & 0xFFu;
+            decisions[i / 64] |= bits << (i % 64);
+        }
+#endif
+        for (; i < count; ++i) {
+            decisions[i / 64] |= static_cast<uint64_t>(have[i] >= need[i]) << (i % 64);
+        }
+        for (size_t w = 0; w < decisions.size(); ++w) {
+            decisions[w] &= known[w];
+        }
+        return decisions;
+    }
+
     // Вывод информации о всех пользователях
     void displayAllUsers() const {
         for (const auto& user : users_) {
@@ -154,96 +1192,316 @@ public:
     }
 
     // Поиск пользователя по имени
-    User* findUserByName(const std::string& name) const {
-        for (const auto& user : users_) {
-            if (user->getName() == name) {
-                return user.get();
-            }
-        }
-        return nullptr;
+    // (имя, которого нет в пуле, не может принадлежать ни одному пользователю)
+    User* findUserByName(std::string_view name) const {
+        NameId id;
+        return namePool().find(name, id) ? usersByName_.find(id) : nullptr;
     }
 
     // Поиск пользователя по ID
     User* findUserById(int id) const {
-        for (const auto& user : users_) {
-            if (user->getId() == id) {
-                return user.get();
-            }
-        }
-        return nullptr;
+        uint32_t position = usersById_.find(id);
+        return position != IdPositionIndex::npos ? users_[position].get() : nullptr;
     }
 
     // Поиск ресурса по имени
-    Resource* findResourceByName(const std::string& name) const {
-        for (const auto& resource : resources_) {
-            if (resource->getName() == name) {
-                return resource.get();
-            }
-        }
-        return nullptr;
+    Resource* findResourceByName(std::string_view name) const {
+        NameId id;
+        return namePool().find(name, id) ? resourcesByName_.find(id) : nullptr;
     }
 
-    // Сортировка пользователей по уровню доступа
+    // Пользователи с уровнем доступа в [lo, hi], по возрастанию уровня
+    std::vector<User*> usersInLevelRange(int lo, int hi) const {
+        std::vector<User*> result;
+        usersByLevel_.forEachInRange(lo, hi, [&](User* user) { result.push_back(user); });
+        return result;
+    }
+
+    // Пользователи, которым открыт ресурс
+    std::vector<User*> usersWithAccessTo(const Resource& resource) const {
+        return usersInLevelRange(resource.getRequiredAccessLevel(), INT_MAX);
+    }
+
+    // Сортировка пользователей по уровню доступа: порядок берётся из индекса
+    // по уровню (при равных уровнях — по id), повторная сортировка не нужна.
+    // Владение остаётся у users_: индекс задаёт только новую позицию каждого
+    // элемента. userLevels_ переставляется вместе с users_, позиции в индексе
+    // по id обновляются; остальные индексы хранят указатели и не меняются.
     void sortUsersByAccessLevel() {
-        std::sort(users_.begin(), users_.end(),
-            [](const auto& a, const auto& b) {
-                return a->getAccessLevel() < b->getAccessLevel();
+        size_t count = users_.size();
+        // Старые позиции, упорядоченные по адресу объекта: по ним каждый
+        // указатель из индекса находит свою позицию двоичным поиском
+        std::vector<uint32_t> byAddress(count);
+        for (size_t i = 0; i < count; ++i) byAddress[i] = static_cast<uint32_t>(i);
+        std::sort(byAddress.begin(), byAddress.end(), [&](uint32_t a, uint32_t b) {
+            return std::less<const User*>()(users_[a].get(), users_[b].get());
+        });
+
+        // target[i] — новая позиция пользователя со старой позицией i
+        const uint32_t unset = UINT32_MAX;
+        std::vector<uint32_t> target(count, unset);
+        size_t placed = 0;
+        bool inSync = true;
+        usersByLevel_.forEachInRange(0, INT_MAX, [&](const User* user) {
+            auto it = std::lower_bound(byAddress.begin(), byAddress.end(), user, [&](uint32_t i, const User* key) {
+                return std::less<const User*>()(users_[i].get(), key);
             });
+            if (it == byAddress.end() || users_[*it].get() != user || target[*it] != unset) {
+                inSync = false;
+                return;
+            }
+            target[*it] = static_cast<uint32_t>(placed++);
+        });
+        if (!inSync || placed != count) {
+            throw std::logic_error("Access level index is out of sync with users");
+        }
+
+        // Позиции в индексе по id пересчитываются по старым позициям до
+        // любых изменений: при повторяющихся id индекс указывает на первого
+        // из них, и только его запись переносится
+        std::vector<uint8_t> indexed(count);
+        for (size_t i = 0; i < count; ++i) {
+            indexed[i] = usersById_.find(users_[i]->getId()) == i;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (indexed[i]) usersById_.move(users_[i]->getId(), target[i]);
+        }
+
+        // Перестановка на месте по циклам
+        for (size_t i = 0; i < count; ++i) {
+            while (target[i] != i) {
+                uint32_t j = target[i];
+                std::swap(users_[i], users_[j]);
+                std::swap(userLevels_[i], userLevels_[j]);
+                std::swap(target[i], target[j]);
+            }
+        }
     }
 
-    // Сохранение данных в файл
+    // Сохранение данных в файл (атомарная замена). Сначала дожидается
+    // фоновых сохранений, чтобы не писать одновременно в тот же .tmp
     void saveToFile(const std::string& filename) const {
-        std::ofstream file(filename);
-        if (!file.is_open()) throw std::runtime_error("Unable to open file for writing");
+        saver_.wait();
+        writeFileAtomic(filename, format(snapshot()));
+    }
 
-        for (const auto& user : users_) {
-            file << "User: " << user->getName() << "," << user->getId() << "," << user->getAccessLevel() << "\n";
-        }
-        for (const auto& resource : resources_) {
-            file << "Resource: " << resource->getName() << "," << resource->getRequiredAccessLevel() << "\n";
-        }
-        file.close();
+    // Сохранение в фоновом потоке: в вызывающем потоке данные только
+    // копируются, текст собирается и пишется в фоне. Дальнейшие изменения
+    // системы на сохраняемые данные не влияют.
+    void saveToFileAsync(const std::string& filename) const {
+        saver_.save(filename, [copy = snapshot()] { return format(copy); });
+    }
+
+    // Ожидание завершения фоновых сохранений
+    void waitForSaves() const {
+        saver_.wait();
     }
 
-    // Загрузка данных из файла
+    // Загрузка данных из файла. Файл отображается в память и разбирается
+    // параллельно; пользователи и ресурсы добавляются в порядке строк файла.
     void loadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) throw std::runtime_error("Unable to open file for reading");
+        saver_.wait();
+        MappedFile file(filename);
+        std::vector<ParsedRecords> parsed = parseRecordsParallel(file.data(), file.size());
+        const UserTypeRegistry& types = userTypes();
+
+        size_t userCount = 0;
+        size_t resourceCount = 0;
+        for (const auto& chunk : parsed) {
+            userCount += chunk.users.size();
+            resourceCount += chunk.resources.size();
+        }
 
         users_.clear();
         resources_.clear();
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.find("User:") == 0) {
-                // Пример: User: John Doe,1,5
-                std::string name;
-                int id, accessLevel;
-                size_t pos1 = line.find(":") + 2;
-                size_t pos2 = line.find(",");
-                name = line.substr(pos1, pos2 - pos1);
-                pos1 = pos2 + 1;
-                pos2 = line.find(",", pos1);
-                id = std::stoi(line.substr(pos1, pos2 - pos1));
-                accessLevel = std::stoi(line.substr(pos2 + 1));
-                users_.push_back(std::make_unique<User>(name, id, accessLevel));
-            }
-            else if (line.find("Resource:") == 0) {
-                // Пример: Resource: Library,3
-                std::string name;
-                int requiredAccessLevel;
-                size_t pos1 = line.find(":") + 2;
-                size_t pos2 = line.find(",");
-                name = line.substr(pos1, pos2 - pos1);
-                requiredAccessLevel = std::stoi(line.substr(pos2 + 1));
-                resources_.push_back(std::make_unique<Resource>(name, requiredAccessLevel));
+        usersByName_.clear();
+        usersById_.clear();
+        resourcesByName_.clear();
+        usersByLevel_.clear();
+        userLevels_.clear();
+        resourceLevels_.clear();
+        users_.reserve(userCount);
+        userLevels_.reserve(userCount);
+        resources_.reserve(resourceCount);
+        resourceLevels_.reserve(resourceCount);
+        usersByName_.reserve(userCount);
+        usersById_.reserve(userCount);
+        resourcesByName_.reserve(resourceCount);
+        namePool().reserve(userCount + resourceCount);
+        // Индекс по уровню строится одним проходом, в том числе по уже
+        // созданным пользователям, если загрузка прервалась
+        try {
+            for (const auto& chunk : parsed) {
+                for (const auto& record : chunk.users) {
+                    NameId name = namePool().intern(record.name, record.nameHash);
+                    users_.push_back(types.factory(record.type)(name, record.id, record.accessLevel, record.detail));
+                    indexUser(users_.back().get());
+                }
+                for (const auto& record : chunk.resources) {
+                    NameId name = namePool().intern(record.name, record.nameHash);
+                    resources_.push_back(std::make_unique<Resource>(name, record.requiredAccessLevel));
+                    resourcesByName_.insert(resources_.back().get());
+                    resourceLevels_.push_back(record.requiredAccessLevel);
+                }
             }
         }
-        file.close();
+        catch (...) {
+            usersByLevel_.assign(users_);
+            throw;
+        }
+        usersByLevel_.assign(users_);
     }
 };
 
+// Поток, отбрасывающий вывод (для замеров без консоли)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Сравнение поштучной проверки доступа с пакетной
+void runBenchmark() {
+    const int userCount = 200000;
+    const int resourceCount = 64;
+    const size_t pairCount = 2000000;
+
+    AccessControlSystem<User> system;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> level(0, 10);
+    for (int id = 0; id < userCount; ++id) {
+        system.addUser(std::make_unique<User>("user" + std::to_string(id), id, level(rng)));
+    }
+    for (int r = 0; r < resourceCount; ++r) {
+        system.addResource(std::make_unique<Resource>("resource" + std::to_string(r), level(rng)));
+    }
+    std::vector<int> userIds(pairCount);
+    std::vector<int> resourceIds(pairCount);
+    std::uniform_int_distribution<int> pickUser(0, userCount - 1);
+    std::uniform_int_distribution<int> pickResource(0, resourceCount - 1);
+    for (size_t i = 0; i < pairCount; ++i) {
+        userIds[i] = pickUser(rng);
+        resourceIds[i] = pickResource(rng);
+    }
+    std::vector<const Resource*> resources;
+    for (int r = 0; r < resourceCount; ++r) {
+        resources.push_back(system.findResourceByName("resource" + std::to_string(r)));
+    }
+
+    NullBuffer nullBuffer;
+    std::streambuf* original = std::cout.rdbuf(&nullBuffer);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pairCount; ++i) {
+        system.checkAccess(*system.findUserById(userIds[i]), *resources[resourceIds[i]]);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    std::vector<uint64_t> decisions = system.checkAccessBatch(userIds, resourceIds);
+    auto end = std::chrono::steady_clock::now();
+    std::cout.rdbuf(original);
+
+    size_t granted = 0;
+    for (uint64_t word : decisions) {
+        granted += std::bitset<64>(word).count();
+    }
+    double perPair = std::chrono::duration<double>(middle - start).count();
+    double batch = std::chrono::duration<double>(end - middle).count();
+    std::cout << "Pairs checked: " << pairCount << ", granted: " << granted << "\n";
+    std::cout << "Per-pair checkAccess: " << perPair * 1000 << " ms\n";
+    std::cout << "checkAccessBatch:     " << batch * 1000 << " ms (x" << perPair / batch << ")\n";
+}
+
+// Скорость загрузки дампа из userCount пользователей
+void runLoadBenchmark(size_t userCount) {
+    const char* filename = "bench_acl.txt";
+    {
+        AccessControlSystem<User> system;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> level(0, 10);
+        for (size_t id = 0; id < userCount; ++id) {
+            system.addUser(std::make_unique<User>("user" + std::to_string(id), static_cast<int>(id), level(rng)));
+            if (id % 1000 == 0) {
+                system.addResource(std::make_unique<Resource>("resource" + std::to_string(id / 1000), level(rng)));
+            }
+        }
+        system.saveToFile(filename);
+    }
+
+    // Отдельно разбор (параллельная часть) и полная загрузка с созданием объектов
+    double megabytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        MappedFile file(filename);
+        megabytes = static_cast<double>(file.size()) / (1024 * 1024);
+        parseRecordsParallel(file.data(), file.size());
+    }
+    auto middle = std::chrono::steady_clock::now();
+    AccessControlSystem<User> system;
+    system.loadFromFile(filename);
+    auto end = std::chrono::steady_clock::now();
+
+    double parse = std::chrono::duration<double>(middle - start).count();
+    double load = std::chrono::duration<double>(end - middle).count();
+    std::cout << "Users: " << userCount << ", file: " << megabytes << " MB, threads: "
+        << std::max(1u, std::thread::hardware_concurrency()) << "\n";
+    std::cout << "Parse only:   " << parse * 1000 << " ms (" << megabytes / parse << " MB/s)\n";
+    std::cout << "loadFromFile: " << load * 1000 << " ms (" << megabytes / load << " MB/s)\n";
+    std::remove(filename);
+}
+
+// Запросы «кому открыт ресурс»: индекс по уровню против полного прохода
+void runLevelBenchmark(size_t userCount) {
+    const int queryCount = 1000;
+    AccessControlSystem<User> system;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> level(0, 10);
+    std::vector<int> levels(userCount);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t id = 0; id < userCount; ++id) {
+        levels[id] = level(rng);
+        system.addUser(std::make_unique<User>("user" + std::to_string(id), static_cast<int>(id), levels[id]));
+    }
+    auto built = std::chrono::steady_clock::now();
+
+    std::vector<int> required(queryCount);
+    for (int& r : required) r = level(rng);
+    size_t indexed = 0;
+    auto indexStart = std::chrono::steady_clock::now();
+    for (int r : required) {
+        indexed += system.usersWithAccessTo(Resource("audit", r)).size();
+    }
+    auto indexEnd = std::chrono::steady_clock::now();
+    size_t scanned = 0;
+    for (int r : required) {
+        for (size_t i = 0; i < userCount; ++i) {
+            scanned += system.findUserById(static_cast<int>(i))->getAccessLevel() >= r;
+        }
+    }
+    auto scanEnd = std::chrono::steady_clock::now();
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+    std::cout << "Users: " << userCount << ", queries: " << queryCount << ", matches: " << indexed
+        << (indexed == scanned ? "" : " (MISMATCH)") << "\n";
+    std::cout << "addUser with index: " << ms(start, built) / userCount * 1e6 << " ns/user\n";
+    std::cout << "usersWithAccessTo:  " << ms(indexStart, indexEnd) << " ms\n";
+    std::cout << "Full scan:          " << ms(indexEnd, scanEnd) << " ms\n";
+}
+
 // Пример использования
-int main() {
+int main(int argc, char* argv[]) {
+    // --bench [load [users] | levels [users]]
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        if (argc > 2 && std::string(argv[2]) == "load") {
+            runLoadBenchmark(argc > 3 ? std::stoul(argv[3]) : 5000000);
+        }
+        else if (argc > 2 && std::string(argv[2]) == "levels") {
+            runLevelBenchmark(argc > 3 ? std::stoul(argv[3]) : 200000);
+        }
+        else {
+            runBenchmark();
+        }
+        return 0;
+    }
+
     try {
         AccessControlSystem<User> system;
 
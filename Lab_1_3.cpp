@@ -2,6 +2,60 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <algorithm>
+#include <variant>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Правила атаки каждого вида существ: шанс особого удара (в процентах),
+// множитель и прибавка к урону при срабатывании. Всё известно на этапе
+// компиляции, поэтому ядро боя специализируется под каждый вид.
+struct EntityTraits {
+    static constexpr int procChance = 0;
+    static constexpr int procMultiplier = 1;
+    static constexpr int procBonus = 0;
+    static constexpr const char* procText = "";
+};
+
+struct CharacterTraits {
+    static constexpr int procChance = 20;     // Критический удар
+    static constexpr int procMultiplier = 2;
+    static constexpr int procBonus = 0;
+    static constexpr const char* procText = "Critical hit! ";
+};
+
+struct MonsterTraits {
+    static constexpr int procChance = 30;     // Ядовитая атака
+    static constexpr int procMultiplier = 1;
+    static constexpr int procBonus = 5;
+    static constexpr const char* procText = "Poisonous attack! ";
+};
+
+struct BossTraits {
+    static constexpr int procChance = 40;     // Огненный удар
+    static constexpr int procMultiplier = 1;
+    static constexpr int procBonus = 10;
+    static constexpr const char* procText = "Fire Strike! ";
+};
+
+// Урон удара при броске roll из [0, 100); 0, если защита не пробита
+template <typename Traits>
+constexpr int strikeDamage(int attackPower, int defense, int roll) {
+    int damage = attackPower - defense;
+    if (damage <= 0) return 0;
+    return roll < Traits::procChance ? damage * Traits::procMultiplier + Traits::procBonus : damage;
+}
+
+static_assert(strikeDamage<CharacterTraits>(20, 5, 0) == 30, "crit doubles damage");
+static_assert(strikeDamage<BossTraits>(30, 10, 99) == 20, "no proc above the chance");
 
 class Entity {
 protected:
@@ -18,14 +72,7 @@ public:
 
     // Виртуальный метод для атаки
     virtual void attack(Entity& target) {
-        int damage = attackPower - target.getDefense();
-        if (damage > 0) {
-            target.setHealth(target.getHealth() - damage);
-            std::cout << name << " attacks " << target.getName() << " for " << damage << " damage!\n";
-        }
-        else {
-            std::cout << name << " attacks " << target.getName() << ", but it has no effect!\n";
-        }
+        attackAs<EntityTraits>(target);
     }
 
     // Новый метод для лечения
@@ -56,6 +103,24 @@ public:
 
     // Виртуальный деструктор (добавлен для корректного полиморфизма)
     virtual ~Entity() {}
+
+protected:
+    // Общая атака для всех классов: отличаются только правила Traits
+    template <typename Traits>
+    void attackAs(Entity& target) {
+        int roll = Traits::procChance > 0 && attackPower > target.getDefense() ? rand() % 100 : 100;
+        int damage = strikeDamage<Traits>(attackPower, target.getDefense(), roll);
+        if (damage > 0) {
+            if (roll < Traits::procChance) {
+                std::cout << Traits::procText;
+            }
+            target.setHealth(target.getHealth() - damage);
+            std::cout << name << " attacks " << target.getName() << " for " << damage << " damage!\n";
+        }
+        else {
+            std::cout << name << " attacks " << target.getName() << ", but it has no effect!\n";
+        }
+    }
 };
 
 class Character : public Entity {
@@ -65,18 +130,7 @@ public:
 
     // Переопределение метода attack
     void attack(Entity& target) override {
-        int damage = getAttackPower() - target.getDefense();
-        if (damage > 0) {
-            if (rand() % 100 < 20) { // 20% шанс критического удара
-                damage *= 2;
-                std::cout << "Critical hit! ";
-            }
-            target.setHealth(target.getHealth() - damage);
-            std::cout << getName() << " attacks " << target.getName() << " for " << damage << " damage!\n";
-        }
-        else {
-            std::cout << getName() << " attacks " << target.getName() << ", but it has no effect!\n";
-        }
+        attackAs<CharacterTraits>(target); // 20% шанс критического удара
     }
 
     // Переопределение метода heal
@@ -99,18 +153,7 @@ public:
         : Entity(n, h, a, d) {}
 
     void attack(Entity& target) override {
-        int damage = getAttackPower() - target.getDefense();
-        if (damage > 0) {
-            if (rand() % 100 < 30) { // 30% шанс ядовитой атаки
-                damage += 5;
-                std::cout << "Poisonous attack! ";
-            }
-            target.setHealth(target.getHealth() - damage);
-            std::cout << getName() << " attacks " << target.getName() << " for " << damage << " damage!\n";
-        }
-        else {
-            std::cout << getName() << " attacks " << target.getName() << ", but it has no effect!\n";
-        }
+        attackAs<MonsterTraits>(target); // 30% шанс ядовитой атаки
     }
 
     // Переопределение метода displayInfo
@@ -128,18 +171,7 @@ public:
 
     // Переопределение метода attack с уникальной способностью
     void attack(Entity& target) override {
-        int damage = getAttackPower() - target.getDefense();
-        if (damage > 0) {
-            if (rand() % 100 < 40) { // 40% шанс огненного удара
-                damage += 10; // Дополнительный урон от огненного удара
-                std::cout << "Fire Strike! ";
-            }
-            target.setHealth(target.getHealth() - damage);
-            std::cout << getName() << " attacks " << target.getName() << " for " << damage << " damage!\n";
-        }
-        else {
-            std::cout << getName() << " attacks " << target.getName() << ", but it has no effect!\n";
-        }
+        attackAs<BossTraits>(target); // 40% шанс огненного удара (+10 урона)
     }
 
     // Переопределение метода displayInfo
@@ -149,7 +181,434 @@ public:
     }
 };
 
-int main() {
+// ---------------- Симулятор баланса ----------------
+// Тот же бой, что и в attack(), но без вывода и без глобального rand():
+// дуэли идут пачками по всем ядрам, у каждой пачки свой генератор.
+
+// Боец симулятора: характеристики плюс правила атаки в типе
+template <typename Traits>
+struct Combatant {
+    using traits = Traits;
+    std::string name;
+    int health;
+    int attackPower;
+    int defensePower;
+};
+
+// Вид бойца выбирается один раз на пару, а не на каждый удар
+using Fighter = std::variant<Combatant<EntityTraits>, Combatant<CharacterTraits>,
+    Combatant<MonsterTraits>, Combatant<BossTraits>>;
+
+// Снимок существа для симулятора (Boss проверяется раньше Monster)
+Fighter makeFighter(const Entity& entity) {
+    std::string name = entity.getName();
+    int h = entity.getHealth();
+    int a = entity.getAttackPower();
+    int d = entity.getDefense();
+    if (dynamic_cast<const Boss*>(&entity)) return Combatant<BossTraits>{ name, h, a, d };
+    if (dynamic_cast<const Monster*>(&entity)) return Combatant<MonsterTraits>{ name, h, a, d };
+    if (dynamic_cast<const Character*>(&entity)) return Combatant<CharacterTraits>{ name, h, a, d };
+    return Combatant<EntityTraits>{ name, h, a, d };
+}
+
+const std::string& fighterName(const Fighter& fighter) {
+    return std::visit([](const auto& combatant) -> const std::string& { return combatant.name; }, fighter);
+}
+
+// xoshiro256** с состоянием, выведенным через splitmix64 из (seed, пара, пачка):
+// результат не зависит от числа потоков и порядка выполнения пачек
+class DuelRng {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    DuelRng(uint64_t seed, uint64_t stream, uint64_t counter) {
+        uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull) ^ (counter * 0x9E3779B97F4A7C15ull);
+        for (uint64_t& word : s) {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Равномерно в [0, 100) — замена rand() % 100
+    int percent() {
+        return static_cast<int>(((next() >> 32) * 100) >> 32);
+    }
+};
+
+// Один удар по правилам attack() соответствующего класса; возвращает урон.
+// Бросок делается, только если защита пробита, как и в attackAs().
+// Здоровье цели ограничивается так же, как в setHealth (0..100).
+template <typename Traits>
+int strike(const Combatant<Traits>& attacker, int targetDefense, int& targetHealth, DuelRng& rng) {
+    if (attacker.attackPower <= targetDefense) {
+        return 0;
+    }
+    int roll = Traits::procChance > 0 ? rng.percent() : 100;
+    int damage = strikeDamage<Traits>(attacker.attackPower, targetDefense, roll);
+    targetHealth = std::min(100, std::max(0, targetHealth - damage));
+    return damage;
+}
+
+// Итоги дуэлей одной пары «атакующий против защитника»
+struct DuelStats {
+    uint64_t duels = 0;
+    uint64_t attackerWins = 0;
+    uint64_t defenderWins = 0;
+    uint64_t attackerDamage = 0;
+    uint64_t defenderDamage = 0;
+
+    void add(const DuelStats& other) {
+        duels += other.duels;
+        attackerWins += other.attackerWins;
+        defenderWins += other.defenderWins;
+        attackerDamage += other.attackerDamage;
+        defenderDamage += other.defenderDamage;
+    }
+};
+
+// Дуэль до поражения одного из бойцов; атакующий бьёт первым.
+// Если за maxRounds никто не пал (например, оба не пробивают защиту) — ничья.
+template <typename A, typename D>
+void runDuel(const Combatant<A>& attacker, const Combatant<D>& defender, DuelRng& rng, DuelStats& stats) {
+    const int maxRounds = 1000;
+    int attackerHealth = attacker.health;
+    int defenderHealth = defender.health;
+    ++stats.duels;
+    for (int round = 0; round < maxRounds; ++round) {
+        stats.attackerDamage += strike(attacker, defender.defensePower, defenderHealth, rng);
+        if (defenderHealth == 0) {
+            ++stats.attackerWins;
+            return;
+        }
+        stats.defenderDamage += strike(defender, attacker.defensePower, attackerHealth, rng);
+        if (attackerHealth == 0) {
+            ++stats.defenderWins;
+            return;
+        }
+    }
+}
+
+// duelsPerPair дуэлей для каждой упорядоченной пары бойцов.
+// Работа режется на пачки фиксированного размера, потоки разбирают их через
+// атомарный счётчик; у каждой пачки свой слот итогов, сумма — в конце.
+std::vector<DuelStats> simulateDuels(const std::vector<Fighter>& roster, uint64_t duelsPerPair,
+    unsigned threadCount, uint64_t seed) {
+    const uint64_t chunkSize = 16384;
+    const size_t pairCount = roster.size() * roster.size();
+    const uint64_t chunksPerPair = (duelsPerPair + chunkSize - 1) / chunkSize;
+    const uint64_t taskCount = pairCount * chunksPerPair;
+
+    std::vector<DuelStats> chunkStats(taskCount);
+    std::atomic<uint64_t> nextTask{ 0 };
+    auto worker = [&] {
+        for (uint64_t task = nextTask++; task < taskCount; task = nextTask++) {
+            uint64_t pair = task / chunksPerPair;
+            uint64_t chunk = task % chunksPerPair;
+            uint64_t duels = std::min(chunkSize, duelsPerPair - chunk * chunkSize);
+            DuelRng rng(seed, pair, chunk);
+            DuelStats local;
+            // Цикл пачки специализирован под оба вида бойцов
+            std::visit([&](const auto& attacker, const auto& defender) {
+                for (uint64_t i = 0; i < duels; ++i) {
+                    runDuel(attacker, defender, rng, local);
+                }
+            }, roster[pair / roster.size()], roster[pair % roster.size()]);
+            chunkStats[task] = local;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<DuelStats> pairStats(pairCount);
+    for (uint64_t task = 0; task < taskCount; ++task) {
+        pairStats[task / chunksPerPair].add(chunkStats[task]);
+    }
+    return pairStats;
+}
+
+// Таблица «строка — атакующий, столбец — защитник»
+template <typename Cell>
+void printTable(const std::string& title, const std::vector<Fighter>& roster, Cell cell) {
+    std::cout << "\n" << title << "\n" << std::setw(12) << "";
+    for (const auto& defender : roster) {
+        std::cout << std::setw(12) << fighterName(defender);
+    }
+    std::cout << "\n";
+    for (size_t a = 0; a < roster.size(); ++a) {
+        std::cout << std::setw(12) << fighterName(roster[a]);
+        for (size_t d = 0; d < roster.size(); ++d) {
+            std::cout << std::setw(12) << cell(a * roster.size() + d);
+        }
+        std::cout << "\n";
+    }
+}
+
+void runBalanceSimulation(uint64_t duelsPerPair, unsigned threadCount, uint64_t seed) {
+    Character hero("Hero", 100, 20, 10);
+    Monster goblin("Goblin", 50, 15, 5);
+    Monster dragon("Dragon", 150, 25, 20);
+    Boss finalBoss("Fire Lord", 200, 30, 15);
+    std::vector<Fighter> roster = { makeFighter(hero), makeFighter(goblin), makeFighter(dragon), makeFighter(finalBoss) };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<DuelStats> stats = simulateDuels(roster, duelsPerPair, threadCount, seed);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t totalDuels = 0;
+    for (const auto& pair : stats) {
+        totalDuels += pair.duels;
+    }
+    std::cout << "Duels: " << totalDuels << " on " << threadCount << " threads in " << seconds * 1000
+        << " ms (" << totalDuels / seconds << " duels/sec), seed " << seed << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    printTable("Attacker win probability:", roster, [&](size_t i) {
+        return static_cast<double>(stats[i].attackerWins) / stats[i].duels;
+    });
+    printTable("Expected damage dealt by attacker per duel:", roster, [&](size_t i) {
+        return static_cast<double>(stats[i].attackerDamage) / stats[i].duels;
+    });
+    printTable("Expected damage taken by attacker per duel:", roster, [&](size_t i) {
+        return static_cast<double>(stats[i].defenderDamage) / stats[i].duels;
+    });
+}
+
+// ---------------- Пакетное разрешение атак ----------------
+// Атакующий i бьёт защитника i; все характеристики лежат в плотных массивах,
+// поэтому урон, броски и ограничение здоровья считаются по 8 полос AVX2.
+
+// Характеристики группы существ по столбцам
+struct EntityArrays {
+    std::vector<std::string> names; // Нужны только для повествования
+    std::vector<int> health;
+    std::vector<int> attackPower;
+    std::vector<int> defensePower;
+
+    size_t size() const { return health.size(); }
+
+    void reserve(size_t count) {
+        names.reserve(count);
+        health.reserve(count);
+        attackPower.reserve(count);
+        defensePower.reserve(count);
+    }
+
+    void add(const Entity& entity) {
+        names.push_back(entity.getName());
+        health.push_back(entity.getHealth());
+        attackPower.push_back(entity.getAttackPower());
+        defensePower.push_back(entity.getDefense());
+    }
+};
+
+// Итоги одного тика: урон по каждому защитнику (0 — защита не пробита)
+// и бит i в procBits, если у атакующего i сработал особый удар
+struct AttackResults {
+    std::vector<int> damage;
+    std::vector<uint64_t> procBits;
+
+    bool proc(size_t i) const { return (procBits[i / 64] >> (i % 64)) & 1u; }
+};
+
+// Счётчиковый генератор бросков: бросок удара i — чистая функция (ключ тика, i),
+// её можно считать в любой полосе и в любом порядке
+inline uint32_t attackHash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+inline uint32_t tickKey(uint64_t seed, uint64_t tick) {
+    return attackHash(static_cast<uint32_t>(seed) ^ attackHash(static_cast<uint32_t>(seed >> 32) ^
+        attackHash(static_cast<uint32_t>(tick) ^ 0x9E3779B9u)));
+}
+
+// Бросок в [0, 100) для удара index
+inline int attackRoll(uint32_t key, uint32_t index) {
+    return static_cast<int>(((attackHash(index ^ key) >> 16) * 100) >> 16);
+}
+
+// Скалярный вариант для хвоста массива и для проверки SIMD-пути.
+// Как и в attackAs(), здоровье меняется только при пробитой защите.
+template <typename Traits>
+void resolveAttackRange(const EntityArrays& attackers, EntityArrays& defenders, uint32_t key,
+    AttackResults& results, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        int roll = attackRoll(key, static_cast<uint32_t>(i));
+        int damage = strikeDamage<Traits>(attackers.attackPower[i], defenders.defensePower[i], roll);
+        if (damage > 0) {
+            defenders.health[i] = std::min(100, std::max(0, defenders.health[i] - damage));
+            results.procBits[i / 64] |= static_cast<uint64_t>(roll < Traits::procChance) << (i % 64);
+        }
+        results.damage[i] = damage;
+    }
+}
+
+template <typename Traits>
+void resolveAttacks(const EntityArrays& attackers, EntityArrays& defenders, uint64_t seed, uint64_t tick,
+    AttackResults& results, bool useSimd = true) {
+    if (attackers.size() != defenders.size()) {
+        throw std::invalid_argument("Attacker and defender arrays must have the same length");
+    }
+    size_t count = attackers.size();
+    results.damage.resize(count);
+    results.procBits.assign((count + 63) / 64, 0);
+    uint32_t key = tickKey(seed, tick);
+
+    size_t i = 0;
+#if defined(__AVX2__)
+    if (useSimd) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i hundred = _mm256_set1_epi32(100);
+        const __m256i chance = _mm256_set1_epi32(Traits::procChance);
+        const __m256i multiplier = _mm256_set1_epi32(Traits::procMultiplier);
+        const __m256i bonus = _mm256_set1_epi32(Traits::procBonus);
+        const __m256i keys = _mm256_set1_epi32(static_cast<int>(key));
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        auto hash = [](__m256i x) {
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7FEB352D));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+            x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846CA68Bu)));
+            return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+        };
+        for (; i + 8 <= count; i += 8) {
+            __m256i attack = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(attackers.attackPower.data() + i));
+            __m256i defense = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(defenders.defensePower.data() + i));
+            __m256i health = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(defenders.health.data() + i));
+
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lanes);
+            __m256i roll = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(hash(_mm256_xor_si256(index, keys)), 16), hundred), 16);
+
+            // Урон только там, где защита пробита; особый удар — где бросок ниже шанса
+            __m256i raw = _mm256_sub_epi32(attack, defense);
+            __m256i pierced = _mm256_cmpgt_epi32(raw, zero);
+            __m256i proc = _mm256_and_si256(_mm256_cmpgt_epi32(chance, roll), pierced);
+            __m256i boosted = _mm256_add_epi32(_mm256_mullo_epi32(raw, multiplier), bonus);
+            __m256i damage = _mm256_and_si256(_mm256_blendv_epi8(raw, boosted, proc), pierced);
+
+            // setHealth: 0..100, но только для пробитых целей
+            __m256i clamped = _mm256_min_epi32(_mm256_max_epi32(_mm256_sub_epi32(health, damage), zero), hundred);
+            health = _mm256_blendv_epi8(health, clamped, pierced);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(defenders.health.data() + i), health);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(results.damage.data() + i), damage);
+            uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(proc))) & 0xFFu;
+            results.procBits[i / 64] |= bits << (i % 64);
+        }
+    }
+#else
+    (void)useSimd;
+#endif
+    resolveAttackRange<Traits>(attackers, defenders, key, results, i, count);
+}
+
+// Повествование — отдельный проход по итогам тика, те же строки, что и attack()
+template <typename Traits>
+void narrateAttacks(const EntityArrays& attackers, const EntityArrays& defenders, const AttackResults& results,
+    std::ostream& out) {
+    for (size_t i = 0; i < attackers.size(); ++i) {
+        if (results.damage[i] > 0) {
+            if (results.proc(i)) {
+                out << Traits::procText;
+            }
+            out << attackers.names[i] << " attacks " << defenders.names[i] << " for " << results.damage[i] << " damage!\n";
+        }
+        else {
+            out << attackers.names[i] << " attacks " << defenders.names[i] << ", but it has no effect!\n";
+        }
+    }
+}
+
+// entityCount героев против стольких же противников из демо-состава, ticks тиков.
+// Сравнивает SIMD-путь со скалярным и проверяет, что итоги совпадают.
+void runBulkAttacks(size_t entityCount, int ticks, uint64_t seed, bool narrate) {
+    Character hero("Hero", 100, 20, 10);
+    Monster goblin("Goblin", 50, 15, 5);
+    Monster dragon("Dragon", 150, 25, 20);
+    Boss finalBoss("Fire Lord", 200, 30, 15);
+    const Entity* foes[] = { &goblin, &dragon, &finalBoss };
+
+    EntityArrays heroes;
+    EntityArrays defenders;
+    heroes.reserve(entityCount);
+    defenders.reserve(entityCount);
+    for (size_t i = 0; i < entityCount; ++i) {
+        heroes.add(hero);
+        defenders.add(*foes[i % 3]);
+    }
+
+    auto time = [&](EntityArrays& targets, AttackResults& results, bool useSimd) {
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            resolveAttacks<CharacterTraits>(heroes, targets, seed, tick, results, useSimd);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / ticks;
+    };
+
+    EntityArrays scalarTargets = defenders;
+    AttackResults simdResults;
+    AttackResults scalarResults;
+    double simdTime = time(defenders, simdResults, true);
+    double scalarTime = time(scalarTargets, scalarResults, false);
+
+    if (narrate) {
+        narrateAttacks<CharacterTraits>(heroes, defenders, simdResults, std::cout);
+    }
+    bool same = defenders.health == scalarTargets.health && simdResults.damage == scalarResults.damage &&
+        simdResults.procBits == scalarResults.procBits;
+    std::cout << "Entities: " << entityCount << ", ticks: " << ticks << ", seed " << seed
+        << (same ? "" : " (SIMD and scalar results differ!)") << "\n";
+    std::cout << "Scalar: " << scalarTime << " ms/tick\n";
+    std::cout << "SIMD:   " << simdTime << " ms/tick (x" << scalarTime / simdTime << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    // --simulate [дуэлей на пару] [потоков] [seed]
+    if (argc > 1 && std::string(argv[1]) == "--simulate") {
+        uint64_t duels = argc > 2 ? std::stoull(argv[2]) : 1000000;
+        unsigned threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : std::thread::hardware_concurrency();
+        uint64_t seed = argc > 4 ? std::stoull(argv[4]) : static_cast<uint64_t>(time(0));
+        runBalanceSimulation(duels, std::max(1u, threads), seed);
+        return 0;
+    }
+
+    // --resolve [существ] [тиков] [seed] [narrate]
+    if (argc > 1 && std::string(argv[1]) == "--resolve") {
+        size_t entities = argc > 2 ? std::stoull(argv[2]) : 1000000;
+        int ticks = argc > 3 ? std::stoi(argv[3]) : 20;
+        uint64_t seed = argc > 4 ? std::stoull(argv[4]) : static_cast<uint64_t>(time(0));
+        bool narrate = argc > 5 && std::string(argv[5]) == "narrate";
+        runBulkAttacks(entities, std::max(1, ticks), seed, narrate);
+        return 0;
+    }
+
     srand(static_cast<unsigned>(time(0))); // Инициализация генератора случайных чисел
 
     // Создание объектов
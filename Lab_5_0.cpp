@@ -1,6 +1,9 @@
 ﻿#include <iostream>
 #include <string>
 #include <vector>
+#include <memory>
+#include <new>
+#include <utility>
 
 class Character {
 protected:
@@ -65,26 +68,172 @@ public:
 template <typename ItemType>
 class ItemQueue {
 private:
-    std::vector<ItemType> items;
+    ItemType* items = nullptr;
+    size_t capacity = 0;
+    size_t head = 0;
+    size_t count = 0;
+
+    size_t slot(size_t i) const {
+        return (head + i) & (capacity - 1);
+    }
+
+    // Перенос элементов в новый буфер. Старые элементы разрушаются только
+    // после того, как построены все новые: если копирование бросит
+    // исключение, очередь остаётся прежней
+    void relocate(ItemType* newItems, size_t newCapacity) {
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                ::new (static_cast<void*>(newItems + built)) ItemType(std::move_if_noexcept(items[slot(built)]));
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                newItems[i].~ItemType();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            items[slot(i)].~ItemType();
+        }
+        if (items) {
+            std::allocator<ItemType>().deallocate(items, capacity);
+        }
+        items = newItems;
+        capacity = newCapacity;
+        head = 0;
+    }
+
+    void release() {
+        clear();
+        if (items) {
+            std::allocator<ItemType>().deallocate(items, capacity);
+        }
+        items = nullptr;
+        capacity = 0;
+    }
 
 public:
+    ItemQueue() = default;
+
+    // Делегирование конструктору по умолчанию: объект считается построенным,
+    // поэтому если копирование элемента бросит исключение, деструктор
+    // разрушит уже скопированные элементы и освободит буфер
+    ItemQueue(const ItemQueue& other) : ItemQueue() {
+        for (size_t i = 0; i < other.count; ++i) {
+            enqueue(other.items[other.slot(i)]);
+        }
+    }
+
+    ItemQueue(ItemQueue&& other) noexcept
+        : items(other.items), capacity(other.capacity), head(other.head), count(other.count) {
+        other.items = nullptr;
+        other.capacity = other.head = other.count = 0;
+    }
+
+    ItemQueue& operator=(ItemQueue other) noexcept {
+        std::swap(items, other.items);
+        std::swap(capacity, other.capacity);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~ItemQueue() {
+        release();
+    }
+
     void enqueue(const ItemType& item) {
-        items.push_back(item);
+        emplace(item);
     }
 
-    void dequeue() {
-        if (!items.empty()) {
-            items.erase(items.begin());
+    void enqueue(ItemType&& item) {
+        emplace(std::move(item));
+    }
+
+    template <typename... Args>
+    ItemType& emplace(Args&&... args) {
+        if (count < capacity) {
+            ItemType* place = items + slot(count);
+            ::new (static_cast<void*>(place)) ItemType(std::forward<Args>(args)...);
+            ++count;
+            return *place;
+        }
+        // Ёмкость удваивается (всегда степень двойки). Новый элемент строится
+        // до переноса старых: аргументы могут ссылаться на элементы этой очереди
+        size_t newCapacity = capacity == 0 ? 8 : capacity * 2;
+        ItemType* newItems = std::allocator<ItemType>().allocate(newCapacity);
+        ItemType* place = newItems + count;
+        try {
+            ::new (static_cast<void*>(place)) ItemType(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            std::allocator<ItemType>().deallocate(newItems, newCapacity);
+            throw;
+        }
+        try {
+            relocate(newItems, newCapacity);
+        }
+        catch (...) {
+            place->~ItemType();
+            std::allocator<ItemType>().deallocate(newItems, newCapacity);
+            throw;
+        }
+        ++count;
+        return *place;
+    }
+
+    template <typename InputIt>
+    void enqueue_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    template <typename OutputIt>
+    OutputIt drain_into(OutputIt out) {
+        while (count > 0) {
+            ItemType& item = items[head];
+            *out++ = std::move(item);
+            item.~ItemType();
+            head = (head + 1) & (capacity - 1);
+            --count;
         }
-        else {
+        head = 0;
+        return out;
+    }
+
+    void dequeue() {
+        if (count == 0) {
             std::cout << "Queue is empty. Cannot dequeue.\n";
+            return;
         }
+        items[head].~ItemType();
+        head = (head + 1) & (capacity - 1);
+        --count;
+    }
+
+    void clear() {
+        while (count > 0) {
+            items[head].~ItemType();
+            head = (head + 1) & (capacity - 1);
+            --count;
+        }
+        head = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
     }
 
     void showQueue() const {
         std::cout << "Current Queue:\n";
-        for (const auto& item : items) {
-            std::cout << item << std::endl;
+        for (size_t i = 0; i < count; ++i) {
+            std::cout << items[slot(i)] << std::endl;
         }
     }
 };
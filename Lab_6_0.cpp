@@ -1,7 +1,11 @@
 ﻿#include <iostream>
 #include <string>
 #include <vector>
+#include <memory>
+#include <new>
+#include <utility>
 #include <stdexcept>
+#include <chrono>
 
 // Базовый класс для персонажей
 class Character {
@@ -93,6 +97,182 @@ public:
 // Очередь предметов
 template <typename ItemType>
 class ItemQueue {
+private:
+    // Кольцевой буфер: head — индекс первого элемента, count — число элементов
+    ItemType* items = nullptr;
+    size_t capacity = 0;
+    size_t head = 0;
+    size_t count = 0;
+
+    size_t slot(size_t i) const {
+        return (head + i) & (capacity - 1);
+    }
+
+    // Перенос элементов в новый буфер. Старые элементы разрушаются только
+    // после того, как построены все новые: если копирование бросит
+    // исключение, очередь остаётся прежней
+    void relocate(ItemType* newItems, size_t newCapacity) {
+        size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                ::new (static_cast<void*>(newItems + built)) ItemType(std::move_if_noexcept(items[slot(built)]));
+            }
+        }
+        catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                newItems[i].~ItemType();
+            }
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            items[slot(i)].~ItemType();
+        }
+        if (items) {
+            std::allocator<ItemType>().deallocate(items, capacity);
+        }
+        items = newItems;
+        capacity = newCapacity;
+        head = 0;
+    }
+
+    void release() {
+        clear();
+        if (items) {
+            std::allocator<ItemType>().deallocate(items, capacity);
+        }
+        items = nullptr;
+        capacity = 0;
+    }
+
+public:
+    ItemQueue() = default;
+
+    // Делегирование конструктору по умолчанию: объект считается построенным,
+    // поэтому если копирование элемента бросит исключение, деструктор
+    // разрушит уже скопированные элементы и освободит буфер
+    ItemQueue(const ItemQueue& other) : ItemQueue() {
+        for (size_t i = 0; i < other.count; ++i) {
+            enqueue(other.items[other.slot(i)]);
+        }
+    }
+
+    ItemQueue(ItemQueue&& other) noexcept
+        : items(other.items), capacity(other.capacity), head(other.head), count(other.count) {
+        other.items = nullptr;
+        other.capacity = other.head = other.count = 0;
+    }
+
+    ItemQueue& operator=(ItemQueue other) noexcept {
+        std::swap(items, other.items);
+        std::swap(capacity, other.capacity);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~ItemQueue() {
+        release();
+    }
+
+    void enqueue(const ItemType& item) {
+        emplace(item);
+    }
+
+    void enqueue(ItemType&& item) {
+        emplace(std::move(item));
+    }
+
+    template <typename... Args>
+    ItemType& emplace(Args&&... args) {
+        if (count < capacity) {
+            ItemType* place = items + slot(count);
+            ::new (static_cast<void*>(place)) ItemType(std::forward<Args>(args)...);
+            ++count;
+            return *place;
+        }
+        // Ёмкость удваивается (всегда степень двойки). Новый элемент строится
+        // до переноса старых: аргументы могут ссылаться на элементы этой очереди
+        size_t newCapacity = capacity == 0 ? 8 : capacity * 2;
+        ItemType* newItems = std::allocator<ItemType>().allocate(newCapacity);
+        ItemType* place = newItems + count;
+        try {
+            ::new (static_cast<void*>(place)) ItemType(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            std::allocator<ItemType>().deallocate(newItems, newCapacity);
+            throw;
+        }
+        try {
+            relocate(newItems, newCapacity);
+        }
+        catch (...) {
+            place->~ItemType();
+            std::allocator<ItemType>().deallocate(newItems, newCapacity);
+            throw;
+        }
+        ++count;
+        return *place;
+    }
+
+    // Добавление диапазона [first, last)
+    template <typename InputIt>
+    void enqueue_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    // Перенос всех элементов в out в порядке очереди; очередь становится пустой
+    template <typename OutputIt>
+    OutputIt drain_into(OutputIt out) {
+        while (count > 0) {
+            ItemType& item = items[head];
+            *out++ = std::move(item);
+            item.~ItemType();
+            head = (head + 1) & (capacity - 1);
+            --count;
+        }
+        head = 0;
+        return out;
+    }
+
+    void pop() {
+        if (count == 0) {
+            throw EmptyQueueException();
+        }
+        items[head].~ItemType();
+        head = (head + 1) & (capacity - 1);
+        --count;
+    }
+
+    void clear() {
+        while (count > 0) {
+            items[head].~ItemType();
+            head = (head + 1) & (capacity - 1);
+            --count;
+        }
+        head = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    void showQueue() const {
+        std::cout << "Current Queue:\n";
+        for (size_t i = 0; i < count; ++i) {
+            std::cout << items[slot(i)] << std::endl;
+        }
+    }
+};
+
+// Прежняя реализация очереди (vector + erase(begin())) для сравнения
+template <typename ItemType>
+class VectorItemQueue {
 private:
     std::vector<ItemType> items;
 
@@ -108,15 +288,44 @@ public:
         items.erase(items.begin());
     }
 
-    void showQueue() const {
-        std::cout << "Current Queue:\n";
-        for (const auto& item : items) {
-            std::cout << item << std::endl;
-        }
+    bool empty() const {
+        return items.empty();
     }
 };
 
-int main() {
+// Время заполнения и полного опустошения очереди из count элементов, мс
+template <typename Queue>
+double drainTime(size_t count) {
+    auto start = std::chrono::steady_clock::now();
+    Queue queue;
+    for (size_t i = 0; i < count; ++i) {
+        queue.enqueue(static_cast<int>(i));
+    }
+    while (!queue.empty()) {
+        queue.pop();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void runBenchmark() {
+    const size_t count = 10000000;
+    // Старая очередь квадратична, поэтому для неё берём меньший объём
+    const size_t legacyCount = 200000;
+
+    double ring = drainTime<ItemQueue<int>>(count);
+    double legacy = drainTime<VectorItemQueue<int>>(legacyCount);
+    std::cout << "ItemQueue (ring buffer), " << count << " items: " << ring << " ms\n";
+    std::cout << "VectorItemQueue, " << legacyCount << " items: " << legacy << " ms"
+        << " (~" << legacy * (static_cast<double>(count) / legacyCount) * (static_cast<double>(count) / legacyCount) / 1000
+        << " s extrapolated to " << count << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        runBenchmark();
+        return 0;
+    }
+
     GameController<Character*> gameCtrl;
 
     // Проверка добавления некорректного объекта
@@ -4,6 +4,14 @@
 #include <vector>
 #include <chrono>
 #include <cstdlib>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <algorithm>
 
 class Monster {
 public:
@@ -11,6 +19,8 @@ public:
     int health;
     int attack;
 
+    Monster() : health(0), attack(0) {}
+
     Monster(const std::string& name, int health, int attack)
         : name(name), health(health), attack(attack) {}
 
@@ -33,61 +43,403 @@ public:
     }
 };
 
-std::vector<Monster> monsters;
-std::mutex monstersMutex;
-std::mutex battleMutex;
+// Ограниченная lock-free очередь для нескольких производителей и потребителей.
+// У каждой ячейки есть номер последовательности, позиции захватываются одним CAS.
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;
+
+public:
+    explicit BoundedQueue(size_t capacity)
+        : cells(new Cell[capacity]), mask(capacity - 1), enqueuePos(0), dequeuePos(0) {
+        // capacity должна быть степенью двойки
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(T&& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Очередь заполнена
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Очередь пуста
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+BoundedQueue<Monster> monsters(1024);
+std::mutex battleMutex; // Защищает вывод в консоль
+std::atomic<bool> simulationRunning{ true };
+std::atomic<int> heroesAlive{ 0 };
+
+// Счётчики пропускной способности
+std::atomic<uint64_t> spawnCount{ 0 };
+std::atomic<uint64_t> fightCount{ 0 };
+std::atomic<uint64_t> lostCount{ 0 }; // монстры, которым не нашлось места в очереди
 
-void generateMonsters() {
-    while (true) {
-        std::this_thread::sleep_for(std::chrono::seconds(3)); // Новый монстр каждые 3 секунды
-        std::lock_guard<std::mutex> lock(monstersMutex);
-        monsters.push_back(Monster("Goblin", 50, 15));
-        std::cout << "New monster generated!\n";
+void generateMonsters(std::chrono::milliseconds pace) {
+    while (simulationRunning) {
+        std::this_thread::sleep_for(pace); // Новый монстр каждые pace мс
+        Monster monster("Goblin", 50, 15);
+        if (monsters.tryPush(std::move(monster))) {
+            spawnCount.fetch_add(1, std::memory_order_relaxed);
+            if (pace.count() > 0) {
+                std::lock_guard<std::mutex> lock(battleMutex);
+                std::cout << "New monster generated!\n";
+            }
+        }
+        else {
+            std::this_thread::yield(); // Очередь заполнена
+        }
     }
 }
 
-void battle(Character& hero) {
-    while (true) {
-        std::this_thread::sleep_for(std::chrono::seconds(2)); // Интервал между боями
+void battle(Character& hero, std::chrono::milliseconds pace) {
+    Monster monster;
+    while (simulationRunning) {
+        std::this_thread::sleep_for(pace); // Интервал между боями
 
-        std::lock_guard<std::mutex> lock(monstersMutex);
-        if (!monsters.empty()) {
-            Monster& monster = monsters.back(); // Берем последнего монстра
+        if (!monsters.tryPop(monster)) {
+            std::this_thread::yield();
+            continue;
+        }
 
-            // Бой
-            while (hero.health > 0 && monster.health > 0) {
-                // Персонаж атакует монстра
-                monster.health -= hero.attack;
-                std::cout << hero.name << " attacks " << monster.name << " for " << hero.attack << " damage!\n";
+        // Бой идёт без блокировок, текст копится локально и выводится одним куском
+        std::ostringstream log;
+        bool heroDefeated = false;
+        while (hero.health > 0 && monster.health > 0) {
+            // Персонаж атакует монстра
+            monster.health -= hero.attack;
+            log << hero.name << " attacks " << monster.name << " for " << hero.attack << " damage!\n";
 
-                if (monster.health <= 0) {
-                    std::cout << monster.name << " has been defeated!\n";
-                    monsters.pop_back(); // Удаляем монстра из списка
-                    break;
-                }
+            if (monster.health <= 0) {
+                log << monster.name << " has been defeated!\n";
+                break;
+            }
+
+            // Монстр атакует персонажа
+            hero.health -= monster.attack;
+            log << monster.name << " attacks " << hero.name << " for " << monster.attack << " damage!\n";
+
+            if (hero.health <= 0) {
+                log << hero.name << " has been defeated!\n";
+                heroDefeated = true;
+                break;
+            }
+        }
+        fightCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (pace.count() > 0) {
+            std::lock_guard<std::mutex> lock(battleMutex);
+            std::cout << log.str();
+        }
+
+        if (heroDefeated) {
+            // Раненый монстр возвращается в очередь. Пока её разбирают другие
+            // герои, место освободится; если их не осталось, монстр теряется.
+            // Герой выбывает до ожидания, чтобы два проигравших не ждали друг друга
+            bool lastHero = heroesAlive.fetch_sub(1) == 1;
+            bool returned = monsters.tryPush(std::move(monster));
+            while (!returned && simulationRunning && heroesAlive.load() > 0) {
+                std::this_thread::yield();
+                returned = monsters.tryPush(std::move(monster));
+            }
+            if (!returned) {
+                lostCount.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(battleMutex);
+                std::cout << monster.name << " is lost: the monster queue is full\n";
+            }
+            if (lastHero) {
+                simulationRunning = false;
+            }
+            return; // Завершаем бой
+        }
+    }
+}
+
+// Раз в секунду печатает спавны/с и бои/с
+void reportThroughput() {
+    uint64_t lastSpawns = 0;
+    uint64_t lastFights = 0;
+    auto last = std::chrono::steady_clock::now();
+    while (simulationRunning) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - last).count();
+        uint64_t spawns = spawnCount.load();
+        uint64_t fights = fightCount.load();
+        {
+            std::lock_guard<std::mutex> lock(battleMutex);
+            std::cout << "[stats] spawns/sec: " << (spawns - lastSpawns) / seconds
+                << ", fights/sec: " << (fights - lastFights) / seconds << "\n";
+        }
+        lastSpawns = spawns;
+        lastFights = fights;
+        last = now;
+    }
+}
 
-                // Монстр атакует персонажа
-                hero.health -= monster.attack;
-                std::cout << monster.name << " attacks " << hero.name << " for " << monster.attack << " damage!\n";
+// Пул потоков с кражей задач. Задача — индекс; у каждого рабочего своя дека,
+// владелец берёт задачи с конца, остальные крадут с начала.
+class WorkStealingPool {
+private:
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
 
-                if (hero.health <= 0) {
-                    std::cout << hero.name << " has been defeated!\n";
-                    return; // Завершаем бой
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<uint64_t> steals{ 0 };
+
+    bool popLocal(size_t self, size_t& task) {
+        Worker& worker = *workers[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) return false;
+        task = worker.tasks.back();
+        worker.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t self, size_t& task) {
+        for (size_t offset = 1; offset < workers.size(); ++offset) {
+            Worker& victim = *workers[(self + offset) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit WorkStealingPool(size_t threadCount) {
+        if (threadCount == 0) threadCount = 1;
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    size_t size() const { return workers.size(); }
+    uint64_t stealCount() const { return steals.load(); }
+
+    // Выполняет fn(task, worker) для task в [0, taskCount) и ждёт завершения.
+    // Задачи раздаются рабочим непрерывными блоками; новых задач по ходу не
+    // появляется, поэтому рабочий выходит, когда украсть больше нечего.
+    template <typename Fn>
+    void run(size_t taskCount, Fn fn) {
+        size_t blockSize = (taskCount + workers.size() - 1) / workers.size();
+        for (size_t w = 0; w < workers.size(); ++w) {
+            size_t begin = w * blockSize;
+            size_t end = std::min(taskCount, begin + blockSize);
+            for (size_t task = begin; task < end; ++task) {
+                workers[w]->tasks.push_back(task);
+            }
+        }
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < workers.size(); ++w) {
+            threads.emplace_back([this, w, &fn] {
+                size_t task;
+                while (popLocal(w, task) || steal(w, task)) {
+                    fn(task, w);
                 }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+// Детерминированный генератор для одной задачи (splitmix64)
+class TaskRng {
+private:
+    uint64_t state;
+
+public:
+    TaskRng(uint64_t seed, uint64_t task) : state(seed ^ (task * 0x9E3779B97F4A7C15ull)) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Равномерно в [0, bound)
+    int below(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+};
+
+// Итоги боёв одного рабочего (выровнены, чтобы потоки не делили строку кэша)
+struct alignas(64) ArenaTally {
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t rounds = 0;
+};
+
+// Режим арены: heroCount героев проводят по fightsPerHero боёв против монстров
+// из пула. Каждый бой — отдельная задача со своим генератором, без пауз.
+void runArena(int heroCount, int fightsPerHero, uint64_t seed) {
+    std::vector<Character> heroes;
+    heroes.reserve(heroCount);
+    for (int i = 0; i < heroCount; ++i) {
+        heroes.emplace_back("Hero" + std::to_string(i + 1), 100, 20);
+    }
+    const std::vector<Monster> monsterPool = {
+        Monster("Goblin", 50, 15),
+        Monster("Orc", 80, 20),
+        Monster("Troll", 120, 25),
+    };
+
+    WorkStealingPool pool(std::thread::hardware_concurrency());
+    std::vector<ArenaTally> tallies(pool.size());
+    size_t taskCount = static_cast<size_t>(heroCount) * fightsPerHero;
+
+    auto start = std::chrono::steady_clock::now();
+    pool.run(taskCount, [&](size_t task, size_t worker) {
+        TaskRng rng(seed, task);
+        const Character& hero = heroes[task / fightsPerHero];
+        const Monster& monster = monsterPool[rng.below(static_cast<int>(monsterPool.size()))];
+
+        // Урон каждого удара случаен в пределах [attack / 2, attack * 3 / 2]
+        int heroHealth = hero.health;
+        int monsterHealth = monster.health;
+        ArenaTally& tally = tallies[worker];
+        for (;;) {
+            ++tally.rounds;
+            monsterHealth -= hero.attack / 2 + rng.below(hero.attack + 1);
+            if (monsterHealth <= 0) {
+                ++tally.wins;
+                return;
+            }
+            heroHealth -= monster.attack / 2 + rng.below(monster.attack + 1);
+            if (heroHealth <= 0) {
+                ++tally.losses;
+                return;
             }
         }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ArenaTally total;
+    for (const auto& tally : tallies) {
+        total.wins += tally.wins;
+        total.losses += tally.losses;
+        total.rounds += tally.rounds;
     }
+    std::cout << "Arena: " << heroCount << " heroes, " << taskCount << " fights on "
+        << pool.size() << " threads in " << seconds * 1000 << " ms\n";
+    std::cout << "Fights/sec: " << taskCount / seconds << ", rounds/sec: " << total.rounds / seconds
+        << ", steals: " << pool.stealCount() << "\n";
+    std::cout << "Hero wins: " << total.wins << ", losses: " << total.losses << "\n";
 }
 
-int main() {
-    std::thread monsterGenerator(generateMonsters);
-    monsterGenerator.detach(); // Отсоединяем поток генерации монстров
+// Аргументы: [генераторы] [потоки боя] [интервал в мс, 0 — без пауз и без вывода боёв]
+// или: --arena [герои] [боёв на героя] [seed]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--arena") {
+        int heroCount = argc > 2 ? std::atoi(argv[2]) : 10000;
+        int fightsPerHero = argc > 3 ? std::atoi(argv[3]) : 100;
+        uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 42;
+        if (heroCount < 1) heroCount = 1;
+        if (fightsPerHero < 1) fightsPerHero = 1;
+        runArena(heroCount, fightsPerHero, seed);
+        return 0;
+    }
+
+    int generatorCount = argc > 1 ? std::atoi(argv[1]) : 1;
+    int battleCount = argc > 2 ? std::atoi(argv[2]) : 1;
+    int paceMs = argc > 3 ? std::atoi(argv[3]) : 1000;
+    if (generatorCount < 1) generatorCount = 1;
+    if (battleCount < 1) battleCount = 1;
+    if (paceMs < 0) paceMs = 0;
+
+    // По умолчанию: монстр каждые 3 секунды, бой каждые 2 секунды
+    std::chrono::milliseconds spawnPace(paceMs * 3);
+    std::chrono::milliseconds battlePace(paceMs * 2);
 
-    Character hero("Hero", 100, 20);
-    hero.displayInfo();
+    std::vector<std::thread> generators;
+    for (int i = 0; i < generatorCount; ++i) {
+        generators.emplace_back(generateMonsters, spawnPace);
+    }
+
+    std::vector<Character> heroes;
+    for (int i = 0; i < battleCount; ++i) {
+        heroes.emplace_back(battleCount == 1 ? "Hero" : "Hero" + std::to_string(i + 1), 100, 20);
+        heroes.back().displayInfo();
+    }
+    heroesAlive = battleCount;
 
-    std::thread battleThread(battle, std::ref(hero)); // Запускаем поток боя
-    battleThread.join(); // Ждем завершения потока боя
+    auto start = std::chrono::steady_clock::now();
+    std::thread reporter(reportThroughput);
+    std::vector<std::thread> battleThreads;
+    for (auto& hero : heroes) {
+        battleThreads.emplace_back(battle, std::ref(hero), battlePace); // Запускаем поток боя
+    }
+    for (auto& thread : battleThreads) {
+        thread.join(); // Ждем завершения потоков боя
+    }
+    simulationRunning = false;
+    for (auto& thread : generators) {
+        thread.join();
+    }
+    reporter.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Spawns: " << spawnCount << " (" << spawnCount / seconds << "/sec), fights: "
+        << fightCount << " (" << fightCount / seconds << "/sec)\n";
+    if (lostCount > 0) {
+        std::cout << "Monsters lost to a full queue: " << lostCount << "\n";
+    }
 
     return 0;
 }
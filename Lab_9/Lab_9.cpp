@@ -6,141 +6,1352 @@
 #include <sstream>
 #include <ctime>
 #include <limits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <string_view>
+#include <charconv>
+#include <functional>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <cerrno>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Logger backends: Direct reopens the file for every event,
+// Buffered keeps the file open and hands events to a background writer thread,
+// Disabled drops every event (headless simulations).
+enum class LogMode { Direct, Buffered, Disabled };
+
+// Bounded lock-free queue used by the buffered logger.
+// Each cell carries a sequence number so producers and the consumer
+// can claim slots with a single CAS on the shared position.
+template <typename T>
+class LogQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_pos;
+    alignas(64) std::atomic<size_t> dequeue_pos;
+
+public:
+    explicit LogQueue(size_t capacity)
+        : cells(new Cell[capacity]), mask(capacity - 1), enqueue_pos(0), dequeue_pos(0) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("Log queue capacity must be a power of two.");
+        }
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(T&& value) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Queue is full
+            }
+            else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Queue is empty
+            }
+            else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// How Logger<T> writes to its file. Text events get one line each;
+// binary event types overload both functions.
+template <typename T>
+void writeLogHeader(std::ostream& out, const T*) {
+    out << "Log initiated at " << std::time(nullptr) << "\n";
+}
+
+template <typename T>
+void writeLogRecord(std::ostream& out, const T& event) {
+    out << event << "\n";
+}
 
 // Template Logger class for logging game events
 template <typename T>
 class Logger {
 private:
+    static constexpr size_t queue_capacity = 8192;
+    static constexpr size_t batch_size = 256;
+    static constexpr std::chrono::milliseconds flush_interval{ 50 };
+
     std::string log_filename;
+    LogMode mode;
+
+    // Buffered backend state
+    std::ofstream file;
+    std::unique_ptr<LogQueue<T>> queue;
+    std::thread writer;
+    std::mutex state_mutex;
+    std::condition_variable writer_cv;
+    std::condition_variable flushed_cv;
+    std::atomic<uint64_t> pushed_count{ 0 };
+    std::atomic<bool> write_failed{ false };
+    uint64_t written_count = 0;
+    size_t flush_waiters = 0;
+    bool stopping = false;
 
 public:
-    Logger(const std::string& fname) : log_filename(fname) {
-        std::ofstream file(log_filename, std::ios::app);
+    Logger(const std::string& fname, LogMode m = LogMode::Direct) : log_filename(fname), mode(m) {
+        if (mode == LogMode::Disabled) {
+            return;
+        }
+        if (mode == LogMode::Direct) {
+            std::ofstream direct(log_filename, std::ios::app | std::ios::binary);
+            if (!direct.is_open()) {
+                throw std::runtime_error("Unable to open log file: " + log_filename);
+            }
+            writeLogHeader(direct, static_cast<const T*>(nullptr));
+            return;
+        }
+        file.open(log_filename, std::ios::app | std::ios::binary);
         if (!file.is_open()) {
             throw std::runtime_error("Unable to open log file: " + log_filename);
         }
-        file << "Log initiated at " << std::time(nullptr) << "\n";
+        writeLogHeader(file, static_cast<const T*>(nullptr));
+        queue = std::make_unique<LogQueue<T>>(queue_capacity);
+        writer = std::thread(&Logger::writerLoop, this);
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    ~Logger() {
+        if (mode != LogMode::Buffered) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            stopping = true;
+        }
+        writer_cv.notify_one();
+        writer.join();
     }
 
     void log(const T& event) {
-        std::ofstream file(log_filename, std::ios::app);
-        if (!file.is_open()) {
+        if (mode == LogMode::Disabled) {
+            return;
+        }
+        if (mode == LogMode::Direct) {
+            std::ofstream direct(log_filename, std::ios::app | std::ios::binary);
+            if (!direct.is_open()) {
+                throw std::runtime_error("Unable to append to log file: " + log_filename);
+            }
+            writeLogRecord(direct, event);
+            return;
+        }
+        T item(event);
+        while (!queue->tryPush(std::move(item))) {
+            // Queue is full: let the writer catch up
+            writer_cv.notify_one();
+            std::this_thread::yield();
+        }
+        if (pushed_count.fetch_add(1, std::memory_order_relaxed) % batch_size == batch_size - 1) {
+            writer_cv.notify_one();
+        }
+    }
+
+    // Blocks until every event logged before the call has reached the file.
+    void flush() {
+        if (mode != LogMode::Buffered) {
+            return;
+        }
+        uint64_t target = pushed_count.load(std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(state_mutex);
+        ++flush_waiters;
+        writer_cv.notify_one();
+        flushed_cv.wait(lock, [&] { return written_count >= target || write_failed.load(); });
+        --flush_waiters;
+        if (write_failed.load()) {
             throw std::runtime_error("Unable to append to log file: " + log_filename);
         }
-        file << event << "\n";
+    }
+
+private:
+    void writerLoop() {
+        T item;
+        for (;;) {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(state_mutex);
+                writer_cv.wait_for(lock, flush_interval, [&] {
+                    return stopping || flush_waiters > 0 ||
+                        pushed_count.load(std::memory_order_relaxed) - written_count >= batch_size;
+                    });
+                stop = stopping;
+            }
+
+            uint64_t batch = 0;
+            while (queue->tryPop(item)) {
+                writeLogRecord(file, item);
+                ++batch;
+            }
+            file.flush();
+            if (!file) {
+                write_failed.store(true);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                written_count += batch;
+            }
+            flushed_cv.notify_all();
+
+            if (stop && written_count >= pushed_count.load(std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open file for reading: " + filename);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            CloseHandle(file_);
+            throw std::runtime_error("Save file is empty or unreadable: " + filename);
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping_) CloseHandle(mapping_);
+            CloseHandle(file_);
+            throw std::runtime_error("Failed to map file: " + filename);
+        }
+        data_ = static_cast<const char*>(view);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file for reading: " + filename);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Save file is empty or unreadable: " + filename);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            throw std::runtime_error("Failed to map file: " + filename);
+        }
+        data_ = static_cast<const char*>(view);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+#else
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+// Durable file writes. writeFileAtomic writes a temporary file next to the
+// target, flushes it to disk and renames it over the target, so a crash
+// leaves either the old or the new contents, never a mix; on POSIX the
+// directory is flushed too so the rename itself survives a power cut.
+// appendFileDurably adds to the end of a file and flushes it.
+#ifdef _WIN32
+namespace {
+void writeHandle(HANDLE handle, std::string_view data, const std::string& filename) {
+    while (!data.empty()) {
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(data.size(), 1u << 30));
+        DWORD written = 0;
+        if (!WriteFile(handle, data.data(), chunk, &written, nullptr)) {
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+        data.remove_prefix(written);
+    }
+    if (!FlushFileBuffers(handle)) {
+        throw std::runtime_error("Failed to flush file: " + filename);
+    }
+}
+}
+
+void writeFileAtomic(const std::string& filename, std::string_view data) {
+    std::string temp = filename + ".tmp";
+    HANDLE handle = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open file for writing: " + temp);
+    }
+    try {
+        writeHandle(handle, data, temp);
+    }
+    catch (...) {
+        CloseHandle(handle);
+        DeleteFileA(temp.c_str());
+        throw;
+    }
+    CloseHandle(handle);
+    if (!MoveFileExA(temp.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileA(temp.c_str());
+        throw std::runtime_error("Failed to replace file: " + filename);
+    }
+}
+
+void appendFileDurably(const std::string& filename, std::string_view data) {
+    HANDLE handle = CreateFileA(filename.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+    try {
+        writeHandle(handle, data, filename);
+    }
+    catch (...) {
+        CloseHandle(handle);
+        throw;
+    }
+    CloseHandle(handle);
+}
+#else
+namespace {
+void writeDescriptor(int fd, std::string_view data, const std::string& filename) {
+    while (!data.empty()) {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    if (::fsync(fd) != 0) {
+        throw std::runtime_error("Failed to flush file: " + filename);
+    }
+}
+}
+
+void writeFileAtomic(const std::string& filename, std::string_view data) {
+    std::string temp = filename + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file for writing: " + temp);
+    }
+    try {
+        writeDescriptor(fd, data, temp);
+    }
+    catch (...) {
+        ::close(fd);
+        ::unlink(temp.c_str());
+        throw;
+    }
+    if (::close(fd) != 0 || ::rename(temp.c_str(), filename.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        throw std::runtime_error("Failed to replace file: " + filename);
+    }
+
+    size_t slash = filename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : filename.substr(0, slash);
+    int dir = ::open(directory.c_str(), O_RDONLY);
+    if (dir >= 0) {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+
+void appendFileDurably(const std::string& filename, std::string_view data) {
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+    try {
+        writeDescriptor(fd, data, filename);
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+#endif
+
+// Runs durable writes on a worker thread, in submission order. Callers hand
+// over either finished bytes or a function that builds them from a copy of
+// the state, so neither formatting nor the disk holds up the caller. A
+// queued write that a later replace() of the same file makes pointless is
+// dropped, so a slow disk does not pile up snapshots. After a failed write
+// to a file, appends to it are skipped until it is replaced; failed(file)
+// reports that state and wait() rethrows the first error.
+class BackgroundSaver {
+public:
+    using Builder = std::function<std::string()>;
+
+private:
+    struct Job {
+        std::string filename;
+        Builder build;
+        bool append;
+    };
+
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::deque<Job> jobs;
+    std::vector<std::string> failed_files;
+    std::thread worker;
+    bool busy = false;
+    bool stopping = false;
+    std::string error;
+
+    void submit(Job job) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!job.append) {
+            jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+                [&](const Job& queued) { return queued.filename == job.filename; }), jobs.end());
+        }
+        jobs.push_back(std::move(job));
+        if (!worker.joinable()) {
+            worker = std::thread(&BackgroundSaver::run, this);
+        }
+        work_cv.notify_one();
+    }
+
+    bool isFailed(const std::string& filename) const {
+        return std::find(failed_files.begin(), failed_files.end(), filename) != failed_files.end();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            work_cv.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            if (job.append && isFailed(job.filename)) {
+                continue;
+            }
+            busy = true;
+            lock.unlock();
+            std::string failure;
+            try {
+                std::string data = job.build();
+                if (job.append) {
+                    appendFileDurably(job.filename, data);
+                }
+                else {
+                    writeFileAtomic(job.filename, data);
+                }
+            }
+            catch (const std::exception& e) {
+                failure = e.what();
+            }
+            lock.lock();
+            busy = false;
+            if (!failure.empty()) {
+                if (!isFailed(job.filename)) {
+                    failed_files.push_back(job.filename);
+                }
+                if (error.empty()) {
+                    error = std::move(failure);
+                }
+            }
+            else if (!job.append) {
+                failed_files.erase(std::remove(failed_files.begin(), failed_files.end(), job.filename), failed_files.end());
+            }
+            idle_cv.notify_all();
+        }
+    }
+
+public:
+    BackgroundSaver() = default;
+    BackgroundSaver(const BackgroundSaver&) = delete;
+    BackgroundSaver& operator=(const BackgroundSaver&) = delete;
+
+    // Finishes every queued write before returning
+    ~BackgroundSaver() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_cv.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void replace(const std::string& filename, Builder build) {
+        submit(Job{ filename, std::move(build), false });
+    }
+
+    void replace(const std::string& filename, std::string data) {
+        replace(filename, [data = std::move(data)]() mutable { return std::move(data); });
+    }
+
+    void append(const std::string& filename, std::string data) {
+        submit(Job{ filename, [data = std::move(data)]() mutable { return std::move(data); }, true });
+    }
+
+    // True if the last write to `filename` failed and it has not been replaced since
+    bool failed(const std::string& filename) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return isFailed(filename);
+    }
+
+    // Blocks until every write submitted so far is done; throws the first
+    // error since the previous wait()
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle_cv.wait(lock, [&] { return jobs.empty() && !busy; });
+        if (!error.empty()) {
+            std::string message = std::move(error);
+            error.clear();
+            throw std::runtime_error(message);
+        }
+    }
+};
+
+// Helpers for the binary save format (native byte order, strings are u32 length + bytes)
+class BinaryWriter {
+private:
+    std::string& out;
+
+public:
+    explicit BinaryWriter(std::string& buffer) : out(buffer) {}
+
+    template <typename V>
+    void put(V value) {
+        char bytes[sizeof(V)];
+        std::memcpy(bytes, &value, sizeof(V));
+        out.append(bytes, sizeof(V));
+    }
+
+    void putString(std::string_view value) {
+        put(static_cast<uint32_t>(value.size()));
+        out.append(value.data(), value.size());
+    }
+};
+
+class BinaryReader {
+private:
+    const char* cursor;
+    const char* end;
+
+    void require(size_t bytes) const {
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            throw std::runtime_error("Save file is truncated.");
+        }
+    }
+
+public:
+    BinaryReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+    template <typename V>
+    V get() {
+        require(sizeof(V));
+        V value;
+        std::memcpy(&value, cursor, sizeof(V));
+        cursor += sizeof(V);
+        return value;
+    }
+
+    size_t remaining() const { return static_cast<size_t>(end - cursor); }
+
+    // Returned view points into the underlying buffer
+    std::string_view getString() {
+        uint32_t length = get<uint32_t>();
+        require(length);
+        std::string_view value(cursor, length);
+        cursor += length;
+        return value;
+    }
+};
+
+// Handle to an interned name; equal names always get the same id
+enum class NameId : uint32_t {};
+
+// Interned string table. Bytes live in fixed arena blocks that never move, so
+// views handed out stay valid for the program lifetime; an open-addressing
+// table maps text back to ids (0 marks an empty slot).
+class NameTable {
+private:
+    static constexpr size_t block_capacity = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t block_used = 0;
+    size_t block_size = 0;
+    std::vector<const char*> starts;
+    std::vector<uint32_t> lengths;
+    std::vector<size_t> hashes;
+    std::vector<uint32_t> slots;
+
+    const char* store(std::string_view name) {
+        // An empty name needs no bytes, and there may be no block yet to point into
+        if (name.empty()) {
+            return "";
+        }
+        if (name.size() > block_size - block_used) {
+            block_size = std::max(block_capacity, name.size());
+            blocks.emplace_back(new char[block_size]);
+            block_used = 0;
+        }
+        char* place = blocks.back().get() + block_used;
+        std::memcpy(place, name.data(), name.size());
+        block_used += name.size();
+        return place;
+    }
+
+    void growSlots(size_t capacity) {
+        slots.assign(capacity, 0);
+        size_t mask = capacity - 1;
+        for (uint32_t id = 0; id < hashes.size(); ++id) {
+            size_t i = hashes[id] & mask;
+            while (slots[i] != 0) i = (i + 1) & mask;
+            slots[i] = id + 1;
+        }
+    }
+
+    // Slot holding `name`, or the empty slot where it would go
+    size_t slotFor(std::string_view name, size_t hash) const {
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        while (slots[i] != 0) {
+            uint32_t id = slots[i] - 1;
+            if (hashes[id] == hash && std::string_view(starts[id], lengths[id]) == name) {
+                break;
+            }
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+public:
+    std::string_view view(NameId id) const {
+        auto index = static_cast<uint32_t>(id);
+        return std::string_view(starts[index], lengths[index]);
+    }
+
+    size_t size() const { return hashes.size(); }
+
+    NameId intern(std::string_view name) {
+        if ((hashes.size() + 1) * 2 > slots.size()) {
+            growSlots(slots.empty() ? 64 : slots.size() * 2);
+        }
+        size_t hash = std::hash<std::string_view>{}(name);
+        size_t i = slotFor(name, hash);
+        if (slots[i] != 0) {
+            return static_cast<NameId>(slots[i] - 1);
+        }
+        uint32_t id = static_cast<uint32_t>(hashes.size());
+        starts.push_back(store(name));
+        lengths.push_back(static_cast<uint32_t>(name.size()));
+        hashes.push_back(hash);
+        slots[i] = id + 1;
+        return static_cast<NameId>(id);
+    }
+
+    // Lookup without inserting
+    bool find(std::string_view name, NameId& id) const {
+        if (slots.empty()) {
+            return false;
+        }
+        size_t i = slotFor(name, std::hash<std::string_view>{}(name));
+        if (slots[i] == 0) {
+            return false;
+        }
+        id = static_cast<NameId>(slots[i] - 1);
+        return true;
     }
 };
 
-// Inventory class
+// Process-wide pool shared by monster, character and item names
+NameTable& namePool() {
+    static NameTable pool;
+    return pool;
+}
+
+// Item names are ordinary interned names
+using ItemId = NameId;
+
+// Structured game events. Each is a fixed 32-byte record; names are stored
+// as ids local to one log session (0, 1, 2, ... in order of first use) and
+// their text is written once per session as NameText records.
+enum class EventCode : uint8_t {
+    LogStarted = 1,     // text = magic, value1/value2 = start time
+    NameText,           // subject = id, value1 = full length, text = next chunk
+    MonsterAdded,
+    EntityDamaged,      // value1 = damage, value2 = health left
+    EntityDefeated,
+    MonsterResurrected,
+    Attack,             // object = target, value1 = damage
+    AttackNoEffect,     // object = target
+    Healed,             // value1 = amount
+    ExperienceGained,   // value1 = experience
+    LevelUp,            // value1 = new level
+    ItemAdded,          // object = item
+    ItemRemoved,        // object = item
+    CharacterLoaded,
+    MonsterLoaded,
+    ProgressSaved,      // subject = file name
+    ProgressLoaded,     // subject = file name, value1 = monsters if value2 != 0
+    GameEnded
+};
+
+struct GameEvent {
+    EventCode code;
+    uint8_t text_length;
+    uint16_t reserved;
+    NameId subject;
+    NameId object;
+    int32_t value1;
+    int32_t value2;
+    char text[12];
+};
+static_assert(sizeof(GameEvent) == 32, "GameEvent must stay a fixed-size record");
+
+constexpr char event_log_magic[4] = { 'L', 'B', '9', 'L' };
+
+// An event log file starts with this header, written when the file is
+// created; each session then starts with its own LogStarted record
+struct EventLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+constexpr char event_log_file_magic[8] = { 'L', 'B', '9', 'E', 'V', 'L', 'O', 'G' };
+constexpr uint32_t event_log_version = 1;
+
+// Upper bounds the decoder accepts before allocating anything
+constexpr size_t max_log_names = size_t(1) << 24;
+constexpr size_t max_log_name_length = size_t(1) << 16;
+
+inline void writeLogHeader(std::ostream& out, const GameEvent*) {
+    out.seekp(0, std::ios::end);
+    if (out.tellp() != std::streampos(0)) {
+        return;
+    }
+    EventLogHeader header{};
+    std::memcpy(header.magic, event_log_file_magic, sizeof(header.magic));
+    header.version = event_log_version;
+    header.record_size = sizeof(GameEvent);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+inline void writeLogRecord(std::ostream& out, const GameEvent& event) {
+    out.write(reinterpret_cast<const char*>(&event), sizeof(event));
+}
+
+// Game log front end: records events and makes sure every name an event
+// refers to has been written to this log before the event itself.
+class EventLog {
+private:
+    Logger<GameEvent> logger;
+    bool enabled;
+    std::vector<uint32_t> local_ids; // pool id -> session id + 1, 0 = not written yet
+    uint32_t next_local_id = 0;
+
+    // Writes the name on first use and returns its id within this session
+    NameId writeName(NameId id) {
+        auto index = static_cast<uint32_t>(id);
+        if (index < local_ids.size() && local_ids[index] != 0) {
+            return static_cast<NameId>(local_ids[index] - 1);
+        }
+        if (index >= local_ids.size()) {
+            local_ids.resize(std::max<size_t>(index + 1, local_ids.size() * 2), 0);
+        }
+        auto local = static_cast<NameId>(next_local_id++);
+        local_ids[index] = static_cast<uint32_t>(local) + 1;
+
+        std::string_view text = namePool().view(id);
+        size_t offset = 0;
+        do {
+            GameEvent chunk{};
+            chunk.code = EventCode::NameText;
+            chunk.subject = local;
+            chunk.value1 = static_cast<int32_t>(text.size());
+            chunk.text_length = static_cast<uint8_t>(std::min(sizeof(chunk.text), text.size() - offset));
+            std::memcpy(chunk.text, text.data() + offset, chunk.text_length);
+            logger.log(chunk);
+            offset += chunk.text_length;
+        } while (offset < text.size());
+        return local;
+    }
+
+public:
+    EventLog(const std::string& filename, LogMode mode = LogMode::Direct)
+        : logger(filename, mode), enabled(mode != LogMode::Disabled) {
+        if (!enabled) {
+            return;
+        }
+        auto now = static_cast<uint64_t>(std::time(nullptr));
+        GameEvent start{};
+        start.code = EventCode::LogStarted;
+        start.value1 = static_cast<int32_t>(static_cast<uint32_t>(now));
+        start.value2 = static_cast<int32_t>(static_cast<uint32_t>(now >> 32));
+        std::memcpy(start.text, event_log_magic, sizeof(event_log_magic));
+        logger.log(start);
+    }
+
+    void record(EventCode code, NameId subject, int32_t value1 = 0, int32_t value2 = 0) {
+        if (!enabled) {
+            return;
+        }
+        GameEvent event{};
+        event.code = code;
+        event.subject = writeName(subject);
+        event.value1 = value1;
+        event.value2 = value2;
+        logger.log(event);
+    }
+
+    void record(EventCode code, NameId subject, NameId object, int32_t value1 = 0, int32_t value2 = 0) {
+        if (!enabled) {
+            return;
+        }
+        GameEvent event{};
+        event.code = code;
+        event.subject = writeName(subject);
+        event.object = writeName(object);
+        event.value1 = value1;
+        event.value2 = value2;
+        logger.log(event);
+    }
+
+    void flush() { logger.flush(); }
+};
+
+// Turns a binary event log back into the text the game used to write.
+// Returns false if the file is missing or not an event log; throws
+// std::runtime_error naming the offset of the first corrupt record.
+bool decodeEventLog(const std::string& filename, std::ostream& out) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    EventLogHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, event_log_file_magic, sizeof(header.magic)) != 0 ||
+        header.version != event_log_version || header.record_size != sizeof(GameEvent)) {
+        return false;
+    }
+
+    std::vector<std::string> names;
+    GameEvent event;
+    bool started = false;
+    size_t offset = sizeof(header);
+    auto corrupt = [&](const char* reason) {
+        return std::runtime_error("corrupt log at offset " + std::to_string(offset) + ": " + reason);
+    };
+    for (; in.read(reinterpret_cast<char*>(&event), sizeof(event)); offset += sizeof(event)) {
+        if (event.code < EventCode::LogStarted || event.code > EventCode::GameEnded) {
+            throw corrupt("unknown event code");
+        }
+        if (!started && event.code != EventCode::LogStarted) {
+            throw corrupt("event before LogStarted");
+        }
+        // NameText may introduce the next id; other events refer to known ids
+        if (event.code != EventCode::LogStarted) {
+            size_t known = names.size() + (event.code == EventCode::NameText ? 1 : 0);
+            bool has_object = event.code == EventCode::Attack || event.code == EventCode::AttackNoEffect ||
+                event.code == EventCode::ItemAdded || event.code == EventCode::ItemRemoved;
+            if (static_cast<uint32_t>(event.subject) >= known ||
+                (has_object && static_cast<uint32_t>(event.object) >= known)) {
+                throw corrupt("unknown name id");
+            }
+        }
+        if (event.code == EventCode::NameText && static_cast<uint32_t>(event.subject) == names.size()) {
+            if (names.size() >= max_log_names) {
+                throw corrupt("too many names");
+            }
+            names.emplace_back();
+        }
+        static const std::string no_name;
+        auto name = [&](NameId id) -> const std::string& {
+            auto index = static_cast<uint32_t>(id);
+            return index < names.size() ? names[index] : no_name;
+        };
+        const std::string& subject = name(event.subject);
+        switch (event.code) {
+        case EventCode::LogStarted: {
+            if (std::memcmp(event.text, event_log_magic, sizeof(event_log_magic)) != 0) {
+                return false;
+            }
+            // Ids are only meaningful within one session
+            names.clear();
+            started = true;
+            uint64_t time = static_cast<uint32_t>(event.value1) |
+                (static_cast<uint64_t>(static_cast<uint32_t>(event.value2)) << 32);
+            out << "Log initiated at " << time << "\n";
+            break;
+        }
+        case EventCode::NameText: {
+            std::string& text = names[static_cast<uint32_t>(event.subject)];
+            if (event.value1 < 0 || static_cast<size_t>(event.value1) > max_log_name_length) {
+                throw corrupt("bad name length");
+            }
+            if (text.size() >= static_cast<size_t>(event.value1)) {
+                text.clear();
+            }
+            text.append(event.text, std::min<size_t>(event.text_length, sizeof(event.text)));
+            break;
+        }
+        case EventCode::MonsterAdded:
+            out << "Added monster: " << subject << "\n";
+            break;
+        case EventCode::EntityDamaged:
+            out << subject << " takes " << event.value1 << " damage, HP now " << event.value2 << "\n";
+            break;
+        case EventCode::EntityDefeated:
+            out << subject << " has been defeated!\n";
+            break;
+        case EventCode::MonsterResurrected:
+            out << subject << " has been resurrected by the Lich!\n";
+            break;
+        case EventCode::Attack:
+            out << subject << " attacks " << name(event.object) << " for " << event.value1 << " damage!\n";
+            break;
+        case EventCode::AttackNoEffect:
+            out << subject << " attacks " << name(event.object) << ", but it has no effect!\n";
+            break;
+        case EventCode::Healed:
+            out << subject << " heals for " << event.value1 << " HP!\n";
+            break;
+        case EventCode::ExperienceGained:
+            out << subject << " gains " << event.value1 << " experience!\n";
+            break;
+        case EventCode::LevelUp:
+            out << subject << " leveled up to level " << event.value1 << "!\n";
+            break;
+        case EventCode::ItemAdded:
+            out << subject << " added " << name(event.object) << " to inventory.\n";
+            break;
+        case EventCode::ItemRemoved:
+            out << subject << " removed " << name(event.object) << " from inventory.\n";
+            break;
+        case EventCode::CharacterLoaded:
+            out << "Loaded character: " << subject << "\n";
+            break;
+        case EventCode::MonsterLoaded:
+            out << "Loaded monster: " << subject << "\n";
+            break;
+        case EventCode::ProgressSaved:
+            out << "Game progress saved to " << subject << "\n";
+            break;
+        case EventCode::ProgressLoaded:
+            out << "Game progress loaded from " << subject;
+            if (event.value2 != 0) {
+                out << " (" << event.value1 << " monsters)";
+            }
+            out << "\n";
+            break;
+        case EventCode::GameEnded:
+            out << "Game ended.\n";
+            break;
+        }
+    }
+    if (in.gcount() != 0) {
+        throw corrupt("truncated record");
+    }
+    return true;
+}
+
+// Inventory class: item counts keyed by interned item id
 class Inventory {
 private:
-    std::vector<std::string> items_list;
+    struct Entry {
+        ItemId id;
+        uint32_t count;
+    };
+
+    // Dense entries plus an open-addressing index (entry position + 1, 0 = empty)
+    std::vector<Entry> entries;
+    std::vector<uint32_t> slots;
+    size_t total_count = 0;
+
+    static size_t hashId(ItemId id) {
+        return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    size_t slotFor(ItemId id) const {
+        size_t mask = slots.size() - 1;
+        size_t i = hashId(id) & mask;
+        while (slots[i] != 0 && entries[slots[i] - 1].id != id) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void growSlots(size_t capacity) {
+        slots.assign(capacity, 0);
+        for (size_t e = 0; e < entries.size(); ++e) {
+            slots[slotFor(entries[e].id)] = static_cast<uint32_t>(e + 1);
+        }
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    void clearSlot(size_t hole) {
+        size_t mask = slots.size() - 1;
+        size_t i = (hole + 1) & mask;
+        while (slots[i] != 0) {
+            size_t home = hashId(entries[slots[i] - 1].id) & mask;
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[hole] = 0;
+    }
+
+    void add(ItemId id, uint32_t count) {
+        if ((entries.size() + 1) * 2 > slots.size()) {
+            growSlots(slots.empty() ? 16 : slots.size() * 2);
+        }
+        size_t i = slotFor(id);
+        if (slots[i] != 0) {
+            entries[slots[i] - 1].count += count;
+        }
+        else {
+            entries.push_back({ id, count });
+            slots[i] = static_cast<uint32_t>(entries.size());
+        }
+        total_count += count;
+    }
+
+    bool remove(ItemId id) {
+        if (slots.empty()) {
+            return false;
+        }
+        size_t i = slotFor(id);
+        if (slots[i] == 0) {
+            return false;
+        }
+        size_t e = slots[i] - 1;
+        --total_count;
+        if (--entries[e].count > 0) {
+            return true;
+        }
+        clearSlot(i);
+        if (e + 1 != entries.size()) {
+            entries[e] = entries.back();
+            slots[slotFor(entries[e].id)] = static_cast<uint32_t>(e + 1);
+        }
+        entries.pop_back();
+        return true;
+    }
+
+    void reserve(size_t distinct) {
+        entries.reserve(distinct);
+        size_t capacity = 16;
+        while (capacity < distinct * 2) capacity *= 2;
+        if (capacity > slots.size()) growSlots(capacity);
+    }
 
 public:
-    void addItem(const std::string& item) {
+    void addItem(std::string_view item) {
         if (item.empty()) {
             throw std::invalid_argument("Item name must not be empty.");
         }
-        items_list.push_back(item);
-        std::cout << "Added " << item << " to inventory.\n";
+        add(namePool().intern(item), 1);
     }
 
-    void removeItem(const std::string& item) {
-        for (auto it = items_list.begin(); it != items_list.end(); ++it) {
-            if (*it == item) {
-                items_list.erase(it);
-                std::cout << "Removed " << item << " from inventory.\n";
-                return;
+    void removeItem(std::string_view item) {
+        ItemId id;
+        if (!namePool().find(item, id) || !remove(id)) {
+            throw std::invalid_argument("Item " + std::string(item) + " not found in inventory.");
+        }
+    }
+
+    // Bulk variants; removeItems is all-or-nothing
+    template <typename Range>
+    void addItems(const Range& items) {
+        for (const auto& item : items) {
+            addItem(item);
+        }
+    }
+
+    template <typename Range>
+    void removeItems(const Range& items) {
+        std::vector<ItemId> removed;
+        try {
+            for (const auto& item : items) {
+                removeItem(item);
+                ItemId id;
+                namePool().find(item, id);
+                removed.push_back(id);
+            }
+        }
+        catch (...) {
+            for (ItemId id : removed) {
+                add(id, 1);
             }
+            throw;
+        }
+    }
+
+    size_t count(std::string_view item) const {
+        ItemId id;
+        if (slots.empty() || !namePool().find(item, id)) {
+            return 0;
         }
-        throw std::invalid_argument("Item " + item + " not found in inventory.");
+        size_t i = slotFor(id);
+        return slots[i] == 0 ? 0 : entries[slots[i] - 1].count;
     }
 
+    size_t size() const { return total_count; }
+
     void displayInventory() const {
-        if (items_list.empty()) {
+        if (entries.empty()) {
             std::cout << "Inventory is empty.\n";
             return;
         }
         std::cout << "Inventory Contents:\n";
-        for (const auto& item : items_list) {
-            std::cout << "- " << item << "\n";
+        for (const auto& entry : entries) {
+            std::cout << "- " << namePool().view(entry.id);
+            if (entry.count > 1) {
+                std::cout << " x" << entry.count;
+            }
+            std::cout << "\n";
         }
     }
 
+    // Encoding: "#<entries>" then " <length>:<name>*<count>" per distinct item.
+    // Names are length-prefixed, so spaces and commas survive the round trip.
+    size_t serializedSize() const {
+        char digits[24];
+        size_t size = 1 + (std::to_chars(digits, digits + sizeof(digits), entries.size()).ptr - digits);
+        for (const auto& entry : entries) {
+            std::string_view name = namePool().view(entry.id);
+            size += 3 + name.size();
+            size += std::to_chars(digits, digits + sizeof(digits), name.size()).ptr - digits;
+            size += std::to_chars(digits, digits + sizeof(digits), entry.count).ptr - digits;
+        }
+        return size;
+    }
+
+    // Writes the encoding into buffer and returns the number of bytes used
+    size_t serializeInto(char* buffer, size_t capacity) const {
+        if (capacity < serializedSize()) {
+            throw std::length_error("Inventory buffer is too small.");
+        }
+        char* out = buffer;
+        char* end = buffer + capacity;
+        *out++ = '#';
+        out = std::to_chars(out, end, entries.size()).ptr;
+        for (const auto& entry : entries) {
+            std::string_view name = namePool().view(entry.id);
+            *out++ = ' ';
+            out = std::to_chars(out, end, name.size()).ptr;
+            *out++ = ':';
+            std::memcpy(out, name.data(), name.size());
+            out += name.size();
+            *out++ = '*';
+            out = std::to_chars(out, end, entry.count).ptr;
+        }
+        return static_cast<size_t>(out - buffer);
+    }
+
     std::string serialize() const {
-        std::stringstream ss;
-        ss << items_list.size();
-        for (const auto& item : items_list) {
-            ss << " " << item;
+        std::string data(serializedSize(), '\0');
+        data.resize(serializeInto(&data[0], data.size()));
+        return data;
+    }
+
+    // Accepts the encoding above and the older "<count> item item ..." form.
+    // Names are parsed as views and interned straight into the shared table.
+    void deserialize(std::string_view data) {
+        entries.clear();
+        slots.clear();
+        total_count = 0;
+        if (data.empty() || data[0] != '#') {
+            deserializeLegacy(data);
+            return;
+        }
+
+        const char* cursor = data.data() + 1;
+        const char* end = data.data() + data.size();
+        auto number = [&](auto& value) {
+            auto result = std::from_chars(cursor, end, value);
+            if (result.ec != std::errc()) {
+                throw std::runtime_error("Invalid inventory data.");
+            }
+            cursor = result.ptr;
+        };
+        auto expect = [&](char c) {
+            if (cursor == end || *cursor != c) {
+                throw std::runtime_error("Invalid inventory data.");
+            }
+            ++cursor;
+        };
+
+        size_t entry_count;
+        number(entry_count);
+        reserve(std::min(entry_count, data.size() / 4));
+        for (size_t i = 0; i < entry_count; ++i) {
+            size_t length;
+            uint32_t item_count;
+            expect(' ');
+            number(length);
+            expect(':');
+            if (static_cast<size_t>(end - cursor) < length || length == 0) {
+                throw std::runtime_error("Invalid inventory data.");
+            }
+            std::string_view name(cursor, length);
+            cursor += length;
+            expect('*');
+            number(item_count);
+            if (item_count == 0) {
+                throw std::runtime_error("Invalid inventory data.");
+            }
+            add(namePool().intern(name), item_count);
         }
-        return ss.str();
     }
 
-    void deserialize(const std::string& data) {
-        std::istringstream iss(data);
-        size_t count;
-        iss >> count;
-        items_list.clear();
+private:
+    void deserializeLegacy(std::string_view data) {
+        std::istringstream iss{ std::string(data) };
+        size_t item_count = 0;
+        iss >> item_count;
         std::string item;
-        std::getline(iss, item); // Consume whitespace
-        for (size_t i = 0; i < count; ++i) {
-            std::getline(iss, item, ' ');
-            if (!item.empty()) {
-                items_list.push_back(item);
-            }
+        for (size_t i = 0; i < item_count && iss >> item; ++i) {
+            addItem(item);
         }
     }
 };
 
+// Result of applying damage. Defeat is a normal combat outcome, so it is
+// returned rather than thrown; exceptions are left for invalid arguments.
+enum class DamageOutcome { Damaged, Defeated };
+
+// Monster type tags used by the binary save format
+enum class MonsterTag : uint8_t { Skeleton = 1, Lich = 2 };
+
 // Base Monster class
 class Monster {
 protected:
-    std::string name;
+    NameId name;
     int health_points;
     int attack_power;
     int defense_value;
 
 public:
-    Monster(const std::string& n, int h, int a, int d)
-        : name(n), health_points(h), attack_power(a), defense_value(d) {
+    Monster(std::string_view n, int h, int a, int d)
+        : name(namePool().intern(n)), health_points(h), attack_power(a), defense_value(d) {
         validate();
     }
 
     virtual void displayInfo() const {
-        std::cout << "Monster: " << name << ", HP: " << health_points
+        std::cout << "Monster: " << getName() << ", HP: " << health_points
             << ", Attack: " << attack_power << ", Defense: " << defense_value << std::endl;
     }
 
     virtual std::string getType() const = 0;
+    virtual MonsterTag getTag() const = 0;
     virtual std::string serialize() const {
-        return getType() + "," + name + "," + std::to_string(health_points) + "," +
+        return getType() + "," + std::string(getName()) + "," + std::to_string(health_points) + "," +
             std::to_string(attack_power) + "," + std::to_string(defense_value);
     }
 
     virtual ~Monster() = default;
 
-    std::string getName() const { return name; }
+    NameId getNameId() const { return name; }
+    std::string_view getName() const { return namePool().view(name); }
     int getHealth() const { return health_points; }
     int getAttack() const { return attack_power; }
     int getDefense() const { return defense_value; }
 
-    void takeDamage(int damage, Logger<std::string>& logger) {
+    // Defeated when the damage takes HP below zero; HP is then clamped to 0
+    DamageOutcome takeDamage(int damage, EventLog& logger) {
         if (damage < 0) {
             throw std::invalid_argument("Damage must be non-negative.");
         }
         health_points -= damage;
         if (health_points < 0) {
             health_points = 0;
-            logger.log(name + " has been defeated!");
-            throw std::runtime_error("Health dropped below zero for " + name);
+            logger.record(EventCode::EntityDefeated, getNameId());
+            return DamageOutcome::Defeated;
         }
-        logger.log(name + " takes " + std::to_string(damage) + " damage, HP now " + std::to_string(health_points));
+        logger.record(EventCode::EntityDamaged, getNameId(), damage, health_points);
+        return DamageOutcome::Damaged;
     }
 
 protected:
     void validate() const {
         if (health_points <= 0) throw std::invalid_argument("Health must be positive.");
-        if (name.empty()) throw std::invalid_argument("Name must not be empty.");
+        if (getName().empty()) throw std::invalid_argument("Name must not be empty.");
         if (attack_power < 0 || defense_value < 0) throw std::invalid_argument("Attack and defense must be non-negative.");
     }
 };
@@ -148,121 +1359,451 @@ protected:
 // Derived Monster classes
 class Skeleton : public Monster {
 public:
-    Skeleton(const std::string& n, int h = 40, int a = 10, int d = 15)
+    Skeleton(std::string_view n, int h = 40, int a = 10, int d = 15)
         : Monster(n, h, a, d) {
     }
 
     std::string getType() const override { return "Skeleton"; }
+    MonsterTag getTag() const override { return MonsterTag::Skeleton; }
 };
 
 class Lich : public Monster {
 public:
-    Lich(const std::string& n, int h = 600, int a = 35, int d = 25)
+    Lich(std::string_view n, int h = 600, int a = 35, int d = 25)
         : Monster(n, h, a, d) {
     }
 
     std::string getType() const override { return "Lich"; }
+    MonsterTag getTag() const override { return MonsterTag::Lich; }
+};
+
+const char* monsterTypeName(MonsterTag tag) {
+    switch (tag) {
+    case MonsterTag::Skeleton: return "Skeleton";
+    case MonsterTag::Lich: return "Lich";
+    }
+    return "Unknown";
+}
+
+bool monsterTagFromName(std::string_view type, MonsterTag& tag) {
+    if (type == "Skeleton") { tag = MonsterTag::Skeleton; return true; }
+    if (type == "Lich") { tag = MonsterTag::Lich; return true; }
+    return false;
+}
+
+// Stats of a freshly spawned (or resurrected) monster, matching the
+// Skeleton and Lich constructor defaults
+struct MonsterStats {
+    int health;
+    int attack;
+    int defense;
+};
+
+MonsterStats monsterDefaults(MonsterTag tag) {
+    switch (tag) {
+    case MonsterTag::Skeleton: return { 40, 10, 15 };
+    case MonsterTag::Lich: return { 600, 35, 25 };
+    }
+    throw std::runtime_error("Unknown monster tag: " + std::to_string(static_cast<int>(tag)));
+}
+
+// Stable reference to a pooled monster. The generation changes every time
+// the slot is freed, so a handle to an erased monster never aliases the
+// monster that later reuses its slot.
+struct MonsterHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+// Data-oriented monster storage: every attribute lives in its own contiguous
+// column and names are interned once, so combat loops touch only plain ints.
+// Columns are indexed by slot and act as a pool: erased slots go to a free
+// list and are reused by the next add, so a steady spawn/kill cycle never
+// grows the columns. Positions (0..size()-1) follow insertion order through
+// the `order` list and are what the menus and index accessors use.
+class MonsterStore {
+private:
+    std::vector<int> health_column;
+    std::vector<int> attack_column;
+    std::vector<int> defense_column;
+    std::vector<MonsterTag> tag_column;
+    std::vector<NameId> name_column;
+    std::vector<uint32_t> generation_column;
+
+    std::vector<uint32_t> order;      // live slots in display order
+    std::vector<uint32_t> free_slots; // recycled slots, reused last-in first-out
+
+    // Change tracking for incremental saves. Value changes are listed per
+    // slot; adding, erasing or clearing only raises layout_changed, since
+    // positions shift and a full snapshot is due anyway.
+    std::vector<uint32_t> position_column; // slot -> index in `order`
+    std::vector<uint8_t> dirty_column;
+    std::vector<uint32_t> dirty_slots;
+    bool layout_changed = true;
+
+    void markChanged(uint32_t slot) {
+        if (!dirty_column[slot]) {
+            dirty_column[slot] = 1;
+            dirty_slots.push_back(slot);
+        }
+    }
+
+    // Number of monsters with HP > 0 per type tag, kept up to date by every
+    // mutation so Lich checks never scan the columns
+    std::array<size_t, 3> alive_by_tag{};
+
+    void markDead(uint32_t slot) {
+        --alive_by_tag[static_cast<size_t>(tag_column[slot])];
+    }
+
+    void markAlive(uint32_t slot) {
+        ++alive_by_tag[static_cast<size_t>(tag_column[slot])];
+    }
+
+    uint32_t append(MonsterTag tag, NameId name, int health, int attack, int defense) {
+        uint32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+            health_column[slot] = health;
+            attack_column[slot] = attack;
+            defense_column[slot] = defense;
+            tag_column[slot] = tag;
+            name_column[slot] = name;
+            dirty_column[slot] = 0;
+        }
+        else {
+            slot = static_cast<uint32_t>(tag_column.size());
+            health_column.push_back(health);
+            attack_column.push_back(attack);
+            defense_column.push_back(defense);
+            tag_column.push_back(tag);
+            name_column.push_back(name);
+            generation_column.push_back(0);
+            position_column.push_back(0);
+            dirty_column.push_back(0);
+        }
+        position_column[slot] = static_cast<uint32_t>(order.size());
+        order.push_back(slot);
+        layout_changed = true;
+        markAlive(slot);
+        return slot;
+    }
+
+    void release(uint32_t slot) {
+        if (health_column[slot] > 0) {
+            markDead(slot);
+        }
+        ++generation_column[slot];
+        free_slots.push_back(slot);
+    }
+
+public:
+    size_t size() const { return order.size(); }
+    bool empty() const { return order.empty(); }
+    // Slots allocated so far, live or free
+    size_t capacity() const { return tag_column.size(); }
+
+    void reserve(size_t count) {
+        health_column.reserve(count);
+        attack_column.reserve(count);
+        defense_column.reserve(count);
+        tag_column.reserve(count);
+        name_column.reserve(count);
+        generation_column.reserve(count);
+        position_column.reserve(count);
+        dirty_column.reserve(count);
+        order.reserve(count);
+        free_slots.reserve(count);
+    }
+
+    // Same validation rules as the Monster constructor
+    // Throws if add() would reject these values
+    static void validate(MonsterTag tag, std::string_view name, int health, int attack, int defense) {
+        if (tag != MonsterTag::Skeleton && tag != MonsterTag::Lich) {
+            throw std::runtime_error("Unknown monster tag: " + std::to_string(static_cast<int>(tag)));
+        }
+        if (health <= 0) throw std::invalid_argument("Health must be positive.");
+        if (name.empty()) throw std::invalid_argument("Name must not be empty.");
+        if (attack < 0 || defense < 0) throw std::invalid_argument("Attack and defense must be non-negative.");
+    }
+
+    MonsterHandle add(MonsterTag tag, std::string_view name, int health, int attack, int defense) {
+        validate(tag, name, health, attack, defense);
+        uint32_t slot = append(tag, namePool().intern(name), health, attack, defense);
+        return MonsterHandle{ slot, generation_column[slot] };
+    }
+
+    // Monster objects are already validated and interned
+    MonsterHandle add(const Monster& monster) {
+        uint32_t slot = append(monster.getTag(), monster.getNameId(), monster.getHealth(), monster.getAttack(), monster.getDefense());
+        return MonsterHandle{ slot, generation_column[slot] };
+    }
+
+    // Keeps the order of the remaining monsters (the menu numbers depend on it);
+    // handles to the other monsters stay valid
+    void erase(size_t index) {
+        release(order[index]);
+        order.erase(order.begin() + index);
+        for (size_t i = index; i < order.size(); ++i) {
+            position_column[order[i]] = static_cast<uint32_t>(i);
+        }
+        layout_changed = true;
+    }
+
+    // Frees every slot but keeps the storage for the next load
+    void clear() {
+        for (uint32_t slot : order) {
+            ++generation_column[slot];
+            free_slots.push_back(slot);
+        }
+        order.clear();
+        alive_by_tag.fill(0);
+        layout_changed = true;
+    }
+
+    MonsterHandle handleAt(size_t index) const {
+        uint32_t slot = order[index];
+        return MonsterHandle{ slot, generation_column[slot] };
+    }
+
+    // False once the monster behind the handle has been erased
+    bool contains(MonsterHandle handle) const {
+        return handle.slot < generation_column.size() && generation_column[handle.slot] == handle.generation;
+    }
+
+    int health(MonsterHandle handle) const { return health_column[handle.slot]; }
+    std::string_view name(MonsterHandle handle) const { return namePool().view(name_column[handle.slot]); }
+
+    MonsterTag tag(size_t index) const { return tag_column[order[index]]; }
+    NameId nameId(size_t index) const { return name_column[order[index]]; }
+    std::string_view name(size_t index) const { return namePool().view(nameId(index)); }
+    int health(size_t index) const { return health_column[order[index]]; }
+    int attack(size_t index) const { return attack_column[order[index]]; }
+    int defense(size_t index) const { return defense_column[order[index]]; }
+
+    void reset(size_t index, int health, int attack, int defense) {
+        uint32_t slot = order[index];
+        bool was_alive = health_column[slot] > 0;
+        if (was_alive && health <= 0) markDead(slot);
+        if (!was_alive && health > 0) markAlive(slot);
+        health_column[slot] = health;
+        attack_column[slot] = attack;
+        defense_column[slot] = defense;
+        markChanged(slot);
+    }
+
+    bool layoutChanged() const { return layout_changed; }
+    bool hasChanges() const { return layout_changed || !dirty_slots.empty(); }
+
+    // Calls visit(index) for every monster whose values changed since
+    // markSaved(); only meaningful while layoutChanged() is false
+    template <typename Visit>
+    void forEachChanged(Visit visit) const {
+        for (uint32_t slot : dirty_slots) {
+            visit(static_cast<size_t>(position_column[slot]));
+        }
+    }
+
+    void markSaved() {
+        for (uint32_t slot : dirty_slots) {
+            dirty_column[slot] = 0;
+        }
+        dirty_slots.clear();
+        layout_changed = false;
+    }
+
+    // Same semantics as Monster::takeDamage
+    DamageOutcome takeDamage(size_t index, int damage, EventLog& logger) {
+        if (damage < 0) {
+            throw std::invalid_argument("Damage must be non-negative.");
+        }
+        uint32_t slot = order[index];
+        int& health_points = health_column[slot];
+        bool was_alive = health_points > 0;
+        health_points -= damage;
+        markChanged(slot);
+        if (was_alive && health_points <= 0) {
+            markDead(slot);
+        }
+        if (health_points < 0) {
+            health_points = 0;
+            logger.record(EventCode::EntityDefeated, nameId(index));
+            return DamageOutcome::Defeated;
+        }
+        logger.record(EventCode::EntityDamaged, nameId(index), damage, health_points);
+        return DamageOutcome::Damaged;
+    }
+
+    size_t aliveCount(MonsterTag wanted) const {
+        return alive_by_tag[static_cast<size_t>(wanted)];
+    }
+
+    bool anyAlive(MonsterTag wanted) const {
+        return aliveCount(wanted) > 0;
+    }
+
+    void displayInfo(size_t index) const {
+        std::cout << "Monster: " << name(index) << ", HP: " << health(index)
+            << ", Attack: " << attack(index) << ", Defense: " << defense(index) << std::endl;
+    }
+
+    // Plain copy of one monster for saving off the game thread. The name
+    // points into the name pool, whose text never moves.
+    struct Row {
+        MonsterTag tag;
+        std::string_view name;
+        int32_t health;
+        int32_t attack;
+        int32_t defense;
+    };
+
+    std::vector<Row> rows() const {
+        std::vector<Row> result;
+        result.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            result.push_back(Row{ tag(i), name(i), health(i), attack(i), defense(i) });
+        }
+        return result;
+    }
+
+    static std::string serialize(const Row& row) {
+        return std::string(monsterTypeName(row.tag)) + "," + std::string(row.name) + "," +
+            std::to_string(row.health) + "," + std::to_string(row.attack) + "," +
+            std::to_string(row.defense);
+    }
+
+    std::string serialize(size_t index) const {
+        return serialize(Row{ tag(index), name(index), health(index), attack(index), defense(index) });
+    }
 };
 
 // Character class
 class Character {
 private:
-    std::string character_name;
+    NameId character_name;
     int health_points;
     int attack_power;
     int defense_value;
     int character_level;
     int exp_points;
     Inventory inventory;
+    bool dirty = true; // changed since the last save
 
 public:
-    Character(const std::string& n, int h, int a, int d)
-        : character_name(n), health_points(h), attack_power(a), defense_value(d), character_level(1), exp_points(0) {
+    Character(std::string_view n, int h, int a, int d)
+        : character_name(namePool().intern(n)), health_points(h), attack_power(a), defense_value(d), character_level(1), exp_points(0) {
         validate();
         inventory.addItem("Sword");
         inventory.addItem("Shield");
     }
 
-    void attackEnemy(Monster& enemy, Logger<std::string>& logger) {
+    // A killing blow is logged as the enemy's defeat only
+    DamageOutcome attackEnemy(Monster& enemy, EventLog& logger) {
         int damage = attack_power - enemy.getDefense();
-        if (damage > 0) {
-            enemy.takeDamage(damage, logger);
-            logger.log(character_name + " attacks " + enemy.getName() + " for " + std::to_string(damage) + " damage!");
+        if (damage <= 0) {
+            logger.record(EventCode::AttackNoEffect, character_name, enemy.getNameId());
+            return DamageOutcome::Damaged;
         }
-        else {
-            logger.log(character_name + " attacks " + enemy.getName() + ", but it has no effect!");
+        if (enemy.takeDamage(damage, logger) == DamageOutcome::Defeated) {
+            return DamageOutcome::Defeated;
+        }
+        logger.record(EventCode::Attack, character_name, enemy.getNameId(), damage);
+        return DamageOutcome::Damaged;
+    }
+
+    DamageOutcome attackEnemy(MonsterStore& monsters, size_t index, EventLog& logger) {
+        int damage = attack_power - monsters.defense(index);
+        if (damage <= 0) {
+            logger.record(EventCode::AttackNoEffect, character_name, monsters.nameId(index));
+            return DamageOutcome::Damaged;
+        }
+        if (monsters.takeDamage(index, damage, logger) == DamageOutcome::Defeated) {
+            return DamageOutcome::Defeated;
         }
+        logger.record(EventCode::Attack, character_name, monsters.nameId(index), damage);
+        return DamageOutcome::Damaged;
     }
 
-    void takeDamage(int damage, Logger<std::string>& logger) {
+    DamageOutcome takeDamage(int damage, EventLog& logger) {
         if (damage < 0) {
             throw std::invalid_argument("Damage must be non-negative.");
         }
         health_points -= damage;
+        dirty = true;
         if (health_points < 0) {
             health_points = 0;
-            logger.log(character_name + " has been defeated!");
-            throw std::runtime_error("Health dropped below zero for " + character_name);
+            logger.record(EventCode::EntityDefeated, getNameId());
+            return DamageOutcome::Defeated;
         }
-        logger.log(character_name + " takes " + std::to_string(damage) + " damage, HP now " + std::to_string(health_points));
+        logger.record(EventCode::EntityDamaged, getNameId(), damage, health_points);
+        return DamageOutcome::Damaged;
     }
 
-    void heal(int amount, Logger<std::string>& logger) {
+    void heal(int amount, EventLog& logger) {
         if (amount < 0) {
             throw std::invalid_argument("Heal amount must Vollständig-negative.");
         }
         health_points += amount;
         if (health_points > 100) health_points = 100;
-        logger.log(character_name + " heals for " + std::to_string(amount) + " HP!");
+        dirty = true;
+        logger.record(EventCode::Healed, character_name, amount);
     }
 
-    void gainExperience(int exp, Logger<std::string>& logger) {
+    void gainExperience(int exp, EventLog& logger) {
         if (exp < 0) {
             throw std::invalid_argument("Experience must be non-negative.");
         }
         exp_points += exp;
-        logger.log(character_name + " gains " + std::to_string(exp) + " experience!");
+        dirty = true;
+        logger.record(EventCode::ExperienceGained, character_name, exp);
         while (exp_points >= 100) {
             character_level++;
             exp_points -= 100;
-            logger.log(character_name + " leveled up to level " + std::to_string(character_level) + "!");
+            logger.record(EventCode::LevelUp, character_name, character_level);
         }
     }
 
-    void addItem(const std::string& item, Logger<std::string>& logger) {
+    void addItem(const std::string& item, EventLog& logger) {
         inventory.addItem(item);
-        logger.log(character_name + " added " + item + " to inventory.");
+        dirty = true;
+        logger.record(EventCode::ItemAdded, character_name, namePool().intern(item));
     }
 
-    void removeItem(const std::string& item, Logger<std::string>& logger) {
+    void removeItem(const std::string& item, EventLog& logger) {
         inventory.removeItem(item);
-        logger.log(character_name + " removed " + item + " from inventory.");
+        dirty = true;
+        logger.record(EventCode::ItemRemoved, character_name, namePool().intern(item));
     }
 
     void displayInfo() const {
-        std::cout << "Name: " << character_name << ", HP: " << health_points
+        std::cout << "Name: " << getName() << ", HP: " << health_points
             << ", Attack: " << attack_power << ", Defense: " << defense_value
             << ", Level: " << character_level << ", Experience: " << exp_points << std::endl;
         inventory.displayInventory();
     }
 
     std::string serialize() const {
-        return character_name + "," + std::to_string(health_points) + "," + std::to_string(attack_power) + "," +
+        return std::string(getName()) + "," + std::to_string(health_points) + "," + std::to_string(attack_power) + "," +
             std::to_string(defense_value) + "," + std::to_string(character_level) + "," +
             std::to_string(exp_points) + "," + inventory.serialize();
     }
 
-    void deserialize(const std::string& data, Logger<std::string>& logger) {
-        std::istringstream iss(data);
-        std::string token;
+    void deserialize(const std::string& data, EventLog& logger) {
+        // Six comma-separated fields, then the inventory as the rest of the line
         std::vector<std::string> tokens;
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
-        }
-        if (tokens.size() < 7) {
-            throw std::runtime_error("Invalid character data format.");
+        size_t start = 0;
+        for (int field = 0; field < 6; ++field) {
+            size_t comma = data.find(',', start);
+            if (comma == std::string::npos) {
+                throw std::runtime_error("Invalid character data format.");
+            }
+            tokens.push_back(data.substr(start, comma - start));
+            start = comma + 1;
         }
-        character_name = tokens[0];
+        tokens.push_back(data.substr(start));
+        if (tokens[0].empty()) throw std::runtime_error("Invalid character data format.");
+        character_name = namePool().intern(tokens[0]);
         try {
             health_points = std::stoi(tokens[1]);
             attack_power = std::stoi(tokens[2]);
@@ -271,52 +1812,183 @@ public:
             exp_points = std::stoi(tokens[5]);
             inventory.deserialize(tokens[6]);
             validate();
+            dirty = true;
         }
         catch (const std::exception& e) {
             throw std::runtime_error("Invalid numeric data in character: " + std::string(e.what()));
         }
-        logger.log("Loaded character: " + character_name);
+        logger.record(EventCode::CharacterLoaded, character_name);
+    }
+
+    void serializeBinary(BinaryWriter& out) const {
+        out.putString(getName());
+        out.put<int32_t>(health_points);
+        out.put<int32_t>(attack_power);
+        out.put<int32_t>(defense_value);
+        out.put<int32_t>(character_level);
+        out.put<int32_t>(exp_points);
+        out.putString(inventory.serialize());
+    }
+
+    // Reads what serializeBinary wrote. Logs nothing: callers restore into a
+    // copy and record the load once it is committed
+    void restoreBinary(BinaryReader& in) {
+        character_name = namePool().intern(in.getString());
+        health_points = in.get<int32_t>();
+        attack_power = in.get<int32_t>();
+        defense_value = in.get<int32_t>();
+        character_level = in.get<int32_t>();
+        exp_points = in.get<int32_t>();
+        inventory.deserialize(in.getString());
+        validate();
+        dirty = true;
     }
 
-    std::string getName() const { return character_name; }
+    bool isDirty() const { return dirty; }
+    void markSaved() { dirty = false; }
+
+    NameId getNameId() const { return character_name; }
+    std::string_view getName() const { return namePool().view(character_name); }
+    int getLevel() const { return character_level; }
     int getHealth() const { return health_points; }
     int getAttack() const { return attack_power; }
     int getDefense() const { return defense_value; }
 private:
     void validate() const {
         if (health_points <= 0) throw std::invalid_argument("Health must be positive.");
-        if (character_name.empty()) throw std::invalid_argument("Name must not be empty.");
+        if (getName().empty()) throw std::invalid_argument("Name must not be empty.");
         if (attack_power < 0 || defense_value < 0) throw std::invalid_argument("Attack and defense must be non-negative.");
         if (character_level < 1) throw std::invalid_argument("Level must be at least 1.");
         if (exp_points < 0) throw std::invalid_argument("Experience must be non-negative.");
     }
 };
 
+// Stream buffer that discards everything (silences std::cout in batch runs)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// How a combat round ended: nobody fell, or who was struck below zero HP
+enum class RoundEnd { None, MonsterDefeated, PlayerDefeated };
+
+// One decision of a headless policy
+struct GameAction {
+    enum Kind { Fight, Heal, Stop };
+    Kind kind;
+    size_t target; // 0-based monster index for Fight
+};
+
+// Aggregate results of a batch of headless games
+struct BatchStats {
+    uint64_t games = 0;
+    uint64_t turns = 0;
+    uint64_t wasted_turns = 0; // actions aimed at a monster that no longer exists
+    uint64_t wins = 0;
+    uint64_t total_level = 0;
+    double seconds = 0;
+
+    double turnsPerSecond() const { return seconds > 0 ? turns / seconds : 0; }
+    double winRate() const { return games ? static_cast<double>(wins) / games : 0; }
+    double averageLevel() const { return games ? static_cast<double>(total_level) / games : 0; }
+};
+
+// Settings of the fixed-timestep world loop
+struct WorldConfig {
+    size_t population = 1000;     // Skeletons kept alive in the world
+    size_t spawn_per_tick = 1000; // refill limit, so one tick never spawns everything at once
+    uint64_t ticks = 600;
+    double tick_rate = 60;        // Hz
+    bool realtime = true;         // sleep out the rest of each tick
+};
+
+// Per-phase timing of the world loop, in milliseconds
+struct WorldMetrics {
+    enum Phase { Spawn, AI, Combat, LogFlush, PhaseCount };
+    static constexpr const char* phase_names[PhaseCount] = { "spawn", "ai", "combat", "log flush" };
+
+    uint64_t ticks = 0;
+    uint64_t monsters_scanned = 0; // monsters the policy had to look at, summed over ticks
+    uint64_t overruns = 0; // ticks that took longer than the budget
+    double budget = 0;
+    std::array<double, PhaseCount> phase_total{};
+    std::array<double, PhaseCount> phase_max{};
+    double frame_total = 0;
+    double frame_max = 0;
+
+    double averageFrame() const { return ticks ? frame_total / ticks : 0; }
+    // Monsters scanned per second of time spent in the AI phase
+    double scansPerSecond() const {
+        return phase_total[AI] > 0 ? monsters_scanned / (phase_total[AI] / 1000) : 0;
+    }
+};
+
+// Parses a command script such as "f1 f1 h f3": fN fights monster N, h heals.
+// The resulting policy repeats the script until the game ends.
+std::vector<GameAction> parseScript(const std::string& script) {
+    std::vector<GameAction> actions;
+    std::istringstream iss(script);
+    std::string token;
+    while (iss >> token) {
+        if (token == "h") {
+            actions.push_back({ GameAction::Heal, 0 });
+        }
+        else if (token.size() > 1 && token[0] == 'f') {
+            size_t target = std::stoul(token.substr(1));
+            if (target < 1) throw std::invalid_argument("Monster numbers start at 1: " + token);
+            actions.push_back({ GameAction::Fight, target - 1 });
+        }
+        else {
+            throw std::invalid_argument("Unknown script command: " + token);
+        }
+    }
+    if (actions.empty()) {
+        throw std::invalid_argument("Script must contain at least one command.");
+    }
+    return actions;
+}
+
 // Game class
 class Game {
 private:
     Character player;
-    std::vector<std::unique_ptr<Monster>> monsters;
-    Logger<std::string> logger;
+    MonsterStore monsters;
+    EventLog logger;
     bool running;
 
+    uint64_t wasted_turns = 0;
+
+    // Incremental save state: the snapshot the journal extends, the epoch
+    // tying the two together and the sizes used to decide on compaction
+    std::string journal_owner;
+    uint64_t save_epoch = 0;
+    size_t snapshot_bytes = 0;
+    size_t journal_bytes = 0;
+
+    // Saves are formatted and written by a background thread
+    BackgroundSaver saver;
+
 public:
-    Game(const std::string& playerName)
-        : player(playerName, 100, 45, 10), logger("game.log"), running(true) {
+    Game(const std::string& playerName, const std::string& logFile = "game_events.log", LogMode logMode = LogMode::Buffered)
+        : player(playerName, 100, 45, 10), logger(logFile, logMode), running(true) {
     }
 
     void addMonster(std::unique_ptr<Monster> monster) {
-        monsters.push_back(std::move(monster));
-        logger.log("Added monster: " + monsters.back()->getName());
+        monsters.add(*monster);
+        logger.record(EventCode::MonsterAdded, monster->getNameId());
+    }
+
+    // Spawns a monster with default stats straight into the pool
+    MonsterHandle addMonster(MonsterTag tag, std::string_view name) {
+        MonsterStats stats = monsterDefaults(tag);
+        MonsterHandle handle = monsters.add(tag, name, stats.health, stats.attack, stats.defense);
+        logger.record(EventCode::MonsterAdded, monsters.nameId(monsters.size() - 1));
+        return handle;
     }
 
     bool isLichAlive() const {
-        for (const auto& monster : monsters) {
-            if (dynamic_cast<Lich*>(monster.get()) && monster->getHealth() > 0) {
-                return true;
-            }
-        }
-        return false;
+        return monsters.anyAlive(MonsterTag::Lich);
     }
 
     void combat() {
@@ -328,8 +2000,8 @@ public:
         // Display available monsters to attack
         std::cout << "\nChoose a monster to attack:\n";
         for (size_t i = 0; i < monsters.size(); ++i) {
-            std::cout << (i + 1) << ". " << monsters[i]->getName()
-                << " (HP: " << monsters[i]->getHealth() << ")\n";
+            std::cout << (i + 1) << ". " << monsters.name(i)
+                << " (HP: " << monsters.health(i) << ")\n";
         }
         std::cout << "Enter the number of the monster to attack: ";
         size_t target_index;
@@ -347,67 +2019,484 @@ public:
         }
         target_index--; // Convert to 0-based index
 
-        auto& monster = *monsters[target_index];
-        std::cout << "\nFighting " << monster.getName() << "!\n";
-
-        bool monster_defeated = false;
-        try {
-            // Player attacks the selected monster
-            player.attackEnemy(monster, logger);
-            if (monster.getHealth() > 0) {
-                // Monster retaliates if still alive
-                int damage = monster.getAttack() - player.getDefense();
-                if (damage < 0) damage = 0; // Clamp negative damage
-                player.takeDamage(damage, logger);
-            }
-            else {
-                monster_defeated = true;
-            }
+        std::cout << "\nFighting " << monsters.name(target_index) << "!\n";
+        NameId target_name = monsters.nameId(target_index);
+        switch (combatRound(target_index)) {
+        case RoundEnd::MonsterDefeated:
+            std::cout << "Combat ended: Health dropped below zero for " << namePool().view(target_name) << "\n";
+            break;
+        case RoundEnd::PlayerDefeated:
+            std::cout << "Combat ended: Health dropped below zero for " << player.getName() << "\n";
+            break;
+        case RoundEnd::None:
+            break;
         }
-        catch (const std::runtime_error& e) {
-            std::cout << "Combat ended: " << e.what() << "\n";
+    }
+
+    // One exchange against monsters[target_index]: the player strikes and the
+    // monster retaliates if still alive. Reports who was struck below zero HP,
+    // if anyone; clears running when the player falls.
+    RoundEnd combatRound(size_t target_index) {
+        RoundEnd ended = RoundEnd::None;
+        if (player.attackEnemy(monsters, target_index, logger) == DamageOutcome::Defeated) {
+            ended = RoundEnd::MonsterDefeated;
             if (player.getHealth() <= 0) {
+                // A player already at 0 HP does not collect the kill
                 running = false;
-                return;
+                return ended;
             }
-            if (monster.getHealth() <= 0) {
-                monster_defeated = true;
+        }
+        else if (monsters.health(target_index) > 0) {
+            // Monster retaliates if still alive
+            int damage = monsters.attack(target_index) - player.getDefense();
+            if (damage < 0) damage = 0; // Clamp negative damage
+            if (player.takeDamage(damage, logger) == DamageOutcome::Defeated) {
+                running = false;
+                return RoundEnd::PlayerDefeated;
             }
+            return RoundEnd::None;
         }
 
         // Handle monster defeat
-        if (monster_defeated) {
-            player.gainExperience(50, logger);
-            if (auto* skeleton = dynamic_cast<Skeleton*>(&monster)) {
-                if (isLichAlive()) {
-                    // Resurrect skeleton immediately
-                    monsters[target_index] = std::make_unique<Skeleton>(skeleton->getName(), 40, 10, 15);
-                    logger.log(skeleton->getName() + " has been resurrected by the Lich!");
+        player.gainExperience(50, logger);
+        if (monsters.tag(target_index) == MonsterTag::Skeleton && isLichAlive()) {
+            // Resurrect skeleton immediately, in its own slot
+            MonsterStats stats = monsterDefaults(MonsterTag::Skeleton);
+            monsters.reset(target_index, stats.health, stats.attack, stats.defense);
+            logger.record(EventCode::MonsterResurrected, monsters.nameId(target_index));
+        }
+        else {
+            monsters.erase(target_index);
+        }
+        return ended;
+    }
+
+    const Character& getPlayer() const { return player; }
+    const MonsterStore& getMonsters() const { return monsters; }
+    bool isRunning() const { return running; }
+    uint64_t getWastedTurns() const { return wasted_turns; }
+
+    // Applies one policy decision without any console interaction.
+    // Fighting a monster number that no longer exists (the list shrinks as
+    // monsters die) wastes the turn. Returns false once the game is over.
+    bool step(const GameAction& action) {
+        if (!running || monsters.empty()) {
+            return false;
+        }
+        switch (action.kind) {
+        case GameAction::Fight:
+            if (action.target >= monsters.size()) {
+                ++wasted_turns;
+                break;
+            }
+            combatRound(action.target);
+            break;
+        case GameAction::Heal:
+            player.heal(20, logger);
+            break;
+        case GameAction::Stop:
+            running = false;
+            break;
+        }
+        return running && !monsters.empty();
+    }
+
+    // Plays `games` independent headless games, each built by setup(game, g)
+    // and driven by `policy` for at most `maxTurns` turns, with logging and
+    // console output suppressed. Combat is deterministic, so games differ only
+    // through what `setup` puts in them. A game is won when every monster has
+    // been removed.
+    template <typename Setup, typename Policy>
+    static BatchStats runBatch(size_t games, size_t maxTurns, Setup setup, Policy policy) {
+        BatchStats stats;
+        NullBuffer null_buffer;
+        std::streambuf* console = std::cout.rdbuf(&null_buffer);
+        auto start = std::chrono::steady_clock::now();
+        try {
+            for (size_t g = 0; g < games; ++g) {
+                Game game("Hero", "", LogMode::Disabled);
+                setup(game, g);
+                size_t turn = 0;
+                while (turn < maxTurns) {
+                    ++turn;
+                    if (!game.step(policy(game, turn - 1))) break;
+                }
+                ++stats.games;
+                stats.turns += turn;
+                stats.wasted_turns += game.wasted_turns;
+                stats.wins += game.monsters.empty() && game.player.getHealth() > 0;
+                stats.total_level += static_cast<uint64_t>(game.player.getLevel());
+            }
+        }
+        catch (...) {
+            std::cout.rdbuf(console);
+            throw;
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout.rdbuf(console);
+        return stats;
+    }
+
+    // Fixed-timestep world loop: every tick refills the population, lets
+    // `policy` look at every monster to pick the player's action, resolves
+    // it and flushes the log, each phase timed separately. With `csv` set,
+    // one line per tick is written there. Stops early if the player falls.
+    template <typename Policy>
+    WorldMetrics runWorld(const WorldConfig& config, Policy policy, std::ostream* csv = nullptr) {
+        using clock = std::chrono::steady_clock;
+        const auto tick_length = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / config.tick_rate));
+        WorldMetrics metrics;
+        metrics.budget = std::chrono::duration<double, std::milli>(tick_length).count();
+        monsters.reserve(config.population);
+        if (csv) {
+            *csv << "tick,spawn_ms,ai_ms,combat_ms,log_flush_ms,frame_ms\n";
+        }
+
+        std::array<double, WorldMetrics::PhaseCount> phase{};
+        auto next_tick = clock::now() + tick_length;
+        for (uint64_t tick = 0; tick < config.ticks && running; ++tick) {
+            auto frame_start = clock::now();
+            auto mark = frame_start;
+            auto lap = [&](WorldMetrics::Phase which) {
+                auto now = clock::now();
+                phase[which] = std::chrono::duration<double, std::milli>(now - mark).count();
+                mark = now;
+            };
+
+            for (size_t spawned = 0; spawned < config.spawn_per_tick && monsters.size() < config.population; ++spawned) {
+                addMonster(MonsterTag::Skeleton, "Skeleton");
+            }
+            lap(WorldMetrics::Spawn);
+            metrics.monsters_scanned += monsters.size();
+            GameAction action = policy(*this);
+            lap(WorldMetrics::AI);
+            step(action);
+            lap(WorldMetrics::Combat);
+            logger.flush();
+            lap(WorldMetrics::LogFlush);
+
+            double frame = std::chrono::duration<double, std::milli>(mark - frame_start).count();
+            ++metrics.ticks;
+            metrics.overruns += frame > metrics.budget;
+            metrics.frame_total += frame;
+            metrics.frame_max = std::max(metrics.frame_max, frame);
+            for (int i = 0; i < WorldMetrics::PhaseCount; ++i) {
+                metrics.phase_total[i] += phase[i];
+                metrics.phase_max[i] = std::max(metrics.phase_max[i], phase[i]);
+            }
+            if (csv) {
+                *csv << tick;
+                for (double ms : phase) *csv << "," << ms;
+                *csv << "," << frame << "\n";
+            }
+
+            if (config.realtime) {
+                // A tick that ran past the next deadline starts the schedule over
+                // instead of trying to catch up with a burst of short ticks
+                if (clock::now() < next_tick) {
+                    std::this_thread::sleep_until(next_tick);
+                    next_tick += tick_length;
                 }
                 else {
-                    monsters.erase(monsters.begin() + target_index);
+                    next_tick = clock::now() + tick_length;
                 }
             }
-            else {
-                monsters.erase(monsters.begin() + target_index);
-            }
         }
+        return metrics;
+    }
+
+    // Blocks until every queued save is on disk; reports the first failure
+    void waitForSaves() {
+        saver.wait();
     }
 
+    // The game thread only copies the monster columns; the text is built
+    // by the saver
     void saveProgress(const std::string& filename) {
-        std::ofstream file(filename);
+        std::string head = player.serialize() + "\n" + std::to_string(monsters.size()) + "\n";
+        saver.replace(filename, [head = std::move(head), rows = monsters.rows()]() {
+            std::string text = head;
+            for (const auto& row : rows) {
+                text += MonsterStore::serialize(row);
+                text += '\n';
+            }
+            return text;
+        });
+        logger.record(EventCode::ProgressSaved, namePool().intern(filename));
+    }
+
+    // Binary snapshot: magic, version, save epoch, player record, monster count,
+    // tagged monster records. Version 1 files have no epoch.
+    static constexpr char snapshot_magic[4] = { 'L', 'B', '9', 'S' };
+    static constexpr uint32_t snapshot_version = 2;
+
+    // Journal next to a snapshot: magic, version, the snapshot's epoch, then
+    // one record per autosave: [payload length u32][payload][checksum u32].
+    // A payload holds an optional player record and the changed monsters, so
+    // a save is replayed entirely or not at all. A journal whose epoch
+    // differs from its snapshot's is stale and ignored.
+    static constexpr char journal_magic[4] = { 'L', 'B', '9', 'J' };
+    static constexpr uint32_t journal_version = 1;
+    static constexpr size_t journal_header_size = sizeof(journal_magic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+    static std::string journalFile(const std::string& snapshot) { return snapshot + ".journal"; }
+
+    // FNV-1a over the record's length and payload
+    static uint32_t journalChecksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Unique enough that a journal left behind by another run never matches
+    uint64_t nextEpoch() const {
+        auto now = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        return std::max(save_epoch + 1, now);
+    }
+
+    // Full save; also starts a new, empty journal for this snapshot. The
+    // game thread copies the monster columns; the saver encodes them.
+    void saveSnapshot(const std::string& filename) {
+        uint64_t epoch = nextEpoch();
+        std::string head;
+        BinaryWriter out(head);
+        head.append(snapshot_magic, sizeof(snapshot_magic));
+        out.put<uint32_t>(snapshot_version);
+        out.put<uint64_t>(epoch);
+        player.serializeBinary(out);
+        out.put<uint64_t>(monsters.size());
+
+        std::vector<MonsterStore::Row> rows = monsters.rows();
+        size_t buffer_size = head.size();
+        for (const auto& row : rows) {
+            buffer_size += sizeof(uint8_t) + sizeof(uint32_t) + row.name.size() + 3 * sizeof(int32_t);
+        }
+        saver.replace(filename, [head = std::move(head), rows = std::move(rows), buffer_size]() {
+            std::string buffer;
+            buffer.reserve(buffer_size);
+            buffer.append(head);
+            BinaryWriter body(buffer);
+            for (const auto& row : rows) {
+                body.put<uint8_t>(static_cast<uint8_t>(row.tag));
+                body.putString(row.name);
+                body.put<int32_t>(row.health);
+                body.put<int32_t>(row.attack);
+                body.put<int32_t>(row.defense);
+            }
+            return buffer;
+        });
+
+        // Written after the snapshot: if this step is lost the old journal
+        // still carries the previous epoch and is ignored on load
+        std::string header(journal_magic, sizeof(journal_magic));
+        BinaryWriter journal(header);
+        journal.put<uint32_t>(journal_version);
+        journal.put<uint64_t>(epoch);
+        size_t header_size = header.size();
+        saver.replace(journalFile(filename), std::move(header));
+
+        save_epoch = epoch;
+        journal_owner = filename;
+        snapshot_bytes = buffer_size;
+        journal_bytes = header_size;
+        player.markSaved();
+        monsters.markSaved();
+        logger.record(EventCode::ProgressSaved, namePool().intern(filename));
+    }
+
+    // Cheap save meant to run every turn: appends what changed since the last
+    // save to the journal of `filename`. Falls back to a full snapshot
+    // (compaction) when monsters were added or removed, when the journal has
+    // outgrown the snapshot, when the journal belongs to another file, or
+    // when a write to either file failed (records may have been lost).
+    void autosave(const std::string& filename) {
+        if (journal_owner != filename || monsters.layoutChanged() || journal_bytes > snapshot_bytes ||
+            saver.failed(filename) || saver.failed(journalFile(filename))) {
+            saveSnapshot(filename);
+            return;
+        }
+        if (!player.isDirty() && !monsters.hasChanges()) {
+            return;
+        }
+
+        std::string record;
+        BinaryWriter out(record);
+        out.put<uint32_t>(0); // payload length, patched below
+        out.put<uint8_t>(player.isDirty());
+        if (player.isDirty()) {
+            player.serializeBinary(out);
+        }
+        size_t count_offset = record.size();
+        out.put<uint64_t>(0);
+        uint64_t changed = 0;
+        monsters.forEachChanged([&](size_t index) {
+            out.put<uint64_t>(index);
+            out.put<int32_t>(monsters.health(index));
+            out.put<int32_t>(monsters.attack(index));
+            out.put<int32_t>(monsters.defense(index));
+            ++changed;
+        });
+        std::memcpy(&record[count_offset], &changed, sizeof(changed));
+        auto length = static_cast<uint32_t>(record.size() - sizeof(uint32_t));
+        std::memcpy(&record[0], &length, sizeof(length));
+        out.put<uint32_t>(journalChecksum(record.data(), record.size()));
+
+        journal_bytes += record.size();
+        saver.append(journalFile(filename), std::move(record));
+        player.markSaved();
+        monsters.markSaved();
+        logger.record(EventCode::ProgressSaved, namePool().intern(filename));
+    }
+
+    // Loads the snapshot, then replays its journal. The whole file is parsed
+    // before anything is replaced, so a bad snapshot leaves the game as it was.
+    void loadSnapshot(const std::string& filename) {
+        waitForSaves();
+        MappedFile mapped(filename);
+        if (mapped.size() < sizeof(snapshot_magic) ||
+            std::memcmp(mapped.data(), snapshot_magic, sizeof(snapshot_magic)) != 0) {
+            throw std::runtime_error("Not a game snapshot: " + filename);
+        }
+        BinaryReader in(mapped.data() + sizeof(snapshot_magic), mapped.size() - sizeof(snapshot_magic));
+        uint32_t version = in.get<uint32_t>();
+        if (version != 1 && version != snapshot_version) {
+            throw std::runtime_error("Unsupported snapshot version: " + std::to_string(version));
+        }
+        uint64_t epoch = version >= 2 ? in.get<uint64_t>() : 0;
+        Character restored = player;
+        restored.restoreBinary(in);
+
+        // A monster takes at least its tag, name length and three stats, so
+        // the count in the file cannot make reserve() outgrow the file itself
+        const size_t min_monster_size = sizeof(uint8_t) + sizeof(uint32_t) + 3 * sizeof(int32_t);
+        uint64_t monsterCount = in.get<uint64_t>();
+        std::vector<MonsterStore::Row> rows;
+        rows.reserve(static_cast<size_t>(std::min<uint64_t>(monsterCount, in.remaining() / min_monster_size)));
+        for (uint64_t i = 0; i < monsterCount; ++i) {
+            auto tag = static_cast<MonsterTag>(in.get<uint8_t>());
+            std::string_view name = in.getString();
+            int health = in.get<int32_t>();
+            int attack = in.get<int32_t>();
+            int defense = in.get<int32_t>();
+            try {
+                MonsterStore::validate(tag, name, health, attack, defense);
+                rows.push_back({ tag, name, health, attack, defense });
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Warning: Failed to load monster: " << e.what() << "\n";
+            }
+        }
+
+        player = std::move(restored);
+        logger.record(EventCode::CharacterLoaded, player.getNameId());
+        monsters.clear();
+        monsters.reserve(rows.size());
+        for (const auto& row : rows) {
+            monsters.add(row.tag, row.name, row.health, row.attack, row.defense);
+        }
+
+        // Journal indexes refer to the saved monster list, so it only applies
+        // if every monster loaded. Anything doubtful leads to a full snapshot
+        // on the next save.
+        bool journal_usable = epoch != 0 && rows.size() == monsterCount && replayJournal(filename, epoch);
+        save_epoch = std::max(save_epoch, epoch);
+        snapshot_bytes = mapped.size();
+        journal_owner = journal_usable ? filename : std::string();
+        player.markSaved();
+        monsters.markSaved();
+        logger.record(EventCode::ProgressLoaded, namePool().intern(filename), static_cast<int32_t>(monsters.size()), 1);
+    }
+
+    // Applies the journal records of `filename` in order. Stops at the first
+    // record that is cut short or fails its checksum (a crash mid-append) and
+    // keeps everything before it. Returns false if the journal is missing,
+    // stale or had to be cut.
+    bool replayJournal(const std::string& filename, uint64_t epoch) {
+        journal_bytes = 0;
+        std::ifstream file(journalFile(filename), std::ios::binary);
         if (!file) {
-            throw std::runtime_error("Failed to open file for writing: " + filename);
+            return false;
+        }
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.size() < journal_header_size || std::memcmp(data.data(), journal_magic, sizeof(journal_magic)) != 0) {
+            return false;
+        }
+        BinaryReader header(data.data() + sizeof(journal_magic), journal_header_size - sizeof(journal_magic));
+        if (header.get<uint32_t>() != journal_version || header.get<uint64_t>() != epoch) {
+            return false;
+        }
+
+        size_t offset = journal_header_size;
+        while (offset < data.size()) {
+            const size_t framing = 2 * sizeof(uint32_t);
+            if (data.size() - offset < framing) {
+                return false;
+            }
+            uint32_t length;
+            std::memcpy(&length, data.data() + offset, sizeof(length));
+            if (data.size() - offset - framing < length) {
+                return false;
+            }
+            uint32_t checksum;
+            std::memcpy(&checksum, data.data() + offset + sizeof(uint32_t) + length, sizeof(checksum));
+            if (checksum != journalChecksum(data.data() + offset, sizeof(uint32_t) + length)) {
+                return false;
+            }
+            if (!applyJournalRecord(BinaryReader(data.data() + offset + sizeof(uint32_t), length))) {
+                return false;
+            }
+            offset += framing + length;
+        }
+        journal_bytes = offset;
+        return true;
+    }
+
+    // One autosave's worth of changes; nothing is applied unless the whole
+    // record is valid
+    bool applyJournalRecord(BinaryReader in) {
+        struct MonsterState {
+            size_t index;
+            int health;
+            int attack;
+            int defense;
+        };
+        try {
+            bool has_player = in.get<uint8_t>() != 0;
+            Character restored = player;
+            if (has_player) {
+                restored.restoreBinary(in);
+            }
+            auto count = in.get<uint64_t>();
+            if (count > in.remaining() / (sizeof(uint64_t) + 3 * sizeof(int32_t))) {
+                return false;
+            }
+            std::vector<MonsterState> states;
+            states.reserve(static_cast<size_t>(count));
+            for (uint64_t i = 0; i < count; ++i) {
+                auto index = in.get<uint64_t>();
+                int health = in.get<int32_t>();
+                int attack = in.get<int32_t>();
+                int defense = in.get<int32_t>();
+                if (index >= monsters.size()) {
+                    return false;
+                }
+                states.push_back({ static_cast<size_t>(index), health, attack, defense });
+            }
+            player = std::move(restored);
+            for (const auto& state : states) {
+                monsters.reset(state.index, state.health, state.attack, state.defense);
+            }
         }
-        file << player.serialize() << "\n";
-        file << monsters.size() << "\n";
-        for (const auto& monster : monsters) {
-            file << monster->serialize() << "\n";
+        catch (const std::exception&) {
+            return false;
         }
-        logger.log("Game progress saved to " + filename);
+        return true;
     }
 
     void loadProgress(const std::string& filename) {
+        waitForSaves();
         std::ifstream file(filename);
         if (!file) {
             throw std::runtime_error("Failed to open file for reading: " + filename);
@@ -438,22 +2527,18 @@ public:
                 throw std::runtime_error("Invalid monster data format: " + line);
             }
             try {
-                if (type == "Skeleton") {
-                    monsters.push_back(std::make_unique<Skeleton>(name, health, attack, defense));
-                }
-                else if (type == "Lich") {
-                    monsters.push_back(std::make_unique<Lich>(name, health, attack, defense));
-                }
-                else {
+                MonsterTag tag;
+                if (!monsterTagFromName(type, tag)) {
                     throw std::runtime_error("Unknown monster type: " + type);
                 }
-                logger.log("Loaded monster: " + name);
+                monsters.add(tag, name, health, attack, defense);
+                logger.record(EventCode::MonsterLoaded, namePool().intern(name));
             }
             catch (const std::exception& e) {
                 std::cerr << "Warning: Failed to load monster: " << e.what() << "\n";
             }
         }
-        logger.log("Game progress loaded from " + filename);
+        logger.record(EventCode::ProgressLoaded, namePool().intern(filename));
     }
 
     void play() {
@@ -463,9 +2548,10 @@ public:
             std::cout << "\nMonsters:\n";
             for (size_t i = 0; i < monsters.size(); ++i) {
                 std::cout << (i + 1) << ". ";
-                monsters[i]->displayInfo();
+                monsters.displayInfo(i);
             }
-            std::cout << "\nOptions: (1) Fight, (2) Heal, (3) Add Item, (4) Remove Item, (5) Save, (6) Load, (7) Exit\n";
+            std::cout << "\nOptions: (1) Fight, (2) Heal, (3) Add Item, (4) Remove Item, (5) Save, (6) Load, (7) Exit,"
+                " (8) Export Text, (9) Import Text\n";
             int choice;
             if (!(std::cin >> choice)) {
                 std::cin.clear();
@@ -487,6 +2573,7 @@ public:
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                     std::getline(std::cin, item);
                     player.addItem(item, logger);
+                    std::cout << "Added " << item << " to inventory.\n";
                     break;
                 }
                 case 4: {
@@ -495,36 +2582,475 @@ public:
                     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                     std::getline(std::cin, item);
                     player.removeItem(item, logger);
+                    std::cout << "Removed " << item << " from inventory.\n";
                     break;
                 }
                 case 5:
-                    saveProgress("game_save.txt");
+                    autosave("game_save.bin");
                     break;
                 case 6:
-                    loadProgress("game_save.txt");
+                    loadSnapshot("game_save.bin");
                     break;
                 case 7:
                     running = false;
                     break;
+                case 8:
+                    saveProgress("game_save.txt");
+                    break;
+                case 9:
+                    loadProgress("game_save.txt");
+                    break;
                 default:
-                    std::cout << "Invalid option. Please choose between 1 and 7.\n";
+                    std::cout << "Invalid option. Please choose between 1 and 9.\n";
                 }
             }
             catch (const std::exception& e) {
                 std::cerr << "Error: " << e.what() << "\n";
             }
         }
-        logger.log("Game ended.");
+        try {
+            waitForSaves();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+        }
+        logger.record(EventCode::GameEnded, player.getNameId());
+        logger.flush();
     }
 };
 
+// Save/load round-trip timing for the text and binary formats
+void runSaveBenchmark(size_t monsterCount) {
+    const char* files[] = { "bench.log", "bench_save.txt", "bench_save.bin", "bench_save.bin.journal" };
+    auto removeFiles = [&] {
+        for (const char* file : files) {
+            std::remove(file);
+        }
+    };
+    // The game (and its log) is closed before the files are removed, also
+    // when a save or load throws
+    try {
+        Game game("Hero", "bench.log");
+        for (size_t i = 0; i < monsterCount; ++i) {
+            if (i % 100 == 0) {
+                game.addMonster(std::make_unique<Lich>("Lich" + std::to_string(i)));
+            }
+            else {
+                game.addMonster(std::make_unique<Skeleton>("Skeleton" + std::to_string(i)));
+            }
+        }
+
+        auto time = [](auto&& action) {
+            auto start = std::chrono::steady_clock::now();
+            action();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        double textSave = time([&] { game.saveProgress("bench_save.txt"); game.waitForSaves(); });
+        double textLoad = time([&] { game.loadProgress("bench_save.txt"); });
+        double binarySave = time([&] { game.saveSnapshot("bench_save.bin"); game.waitForSaves(); });
+        double binaryLoad = time([&] { game.loadSnapshot("bench_save.bin"); });
+
+        std::cout << "Monsters: " << monsterCount << "\n";
+        std::cout << "Text save:   " << textSave << " ms, load: " << textLoad << " ms\n";
+        std::cout << "Binary save: " << binarySave << " ms, load: " << binaryLoad << " ms\n";
+    }
+    catch (...) {
+        removeFiles();
+        throw;
+    }
+    removeFiles();
+}
+
+// Per-turn saving: a full snapshot every turn against the journal autosave,
+// on a Lich fight where only the player and one Skeleton change each turn
+void runAutosaveBenchmark(size_t monsterCount) {
+    const int turns = 200;
+    auto perTurn = [&](bool incremental) {
+        Game game("Hero", "", LogMode::Disabled);
+        game.addMonster(MonsterTag::Lich, "LichKing");
+        for (size_t i = 1; i < monsterCount; ++i) {
+            game.addMonster(MonsterTag::Skeleton, "Skeleton" + std::to_string(i));
+        }
+        game.saveSnapshot("bench_autosave.bin");
+        game.waitForSaves();
+        auto start = std::chrono::steady_clock::now();
+        for (int turn = 0; turn < turns; ++turn) {
+            game.step(GameAction{ GameAction::Fight, 1 });
+            if (incremental) {
+                game.autosave("bench_autosave.bin");
+            }
+            else {
+                game.saveSnapshot("bench_autosave.bin");
+            }
+        }
+        game.waitForSaves();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / turns;
+    };
+    double fullTime = perTurn(false);
+    double journalTime = perTurn(true);
+    std::cout << "Monsters: " << monsterCount << ", turns: " << turns << "\n";
+    std::cout << "Full snapshot: " << fullTime << " ms/turn\n";
+    std::cout << "Journal:       " << journalTime << " ms/turn (x" << fullTime / journalTime << ")\n";
+    std::remove("bench_autosave.bin");
+    std::remove("bench_autosave.bin.journal");
+}
+
+// Per-event logging cost: formatted text lines against binary event records
+void runLogBenchmark(size_t eventCount) {
+    NameId hero = namePool().intern("Hero");
+    NameId skeleton = namePool().intern("Skeleton1");
+    auto perEvent = [&](auto&& action) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < eventCount; ++i) {
+            action(static_cast<int>(i % 100));
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / eventCount;
+    };
+
+    double textTime;
+    {
+        Logger<std::string> text("bench_text.log", LogMode::Buffered);
+        textTime = perEvent([&](int damage) {
+            text.log(std::string(namePool().view(hero)) + " attacks " + std::string(namePool().view(skeleton)) +
+                " for " + std::to_string(damage) + " damage!");
+        });
+        text.flush();
+    }
+    double eventTime;
+    {
+        EventLog events("bench_events.log", LogMode::Buffered);
+        eventTime = perEvent([&](int damage) {
+            events.record(EventCode::Attack, hero, skeleton, damage);
+        });
+        events.flush();
+    }
+    std::cout << "Events: " << eventCount << "\n";
+    std::cout << "Text log:   " << textTime << " ns/event\n";
+    std::cout << "Binary log: " << eventTime << " ns/event\n";
+    std::remove("bench_text.log");
+    std::remove("bench_events.log");
+}
+
+// Inventory serialization: the old stringstream round trip against the buffer
+// encoding. The old side writes exactly what the old Inventory::serialize did
+// and restores through the same istringstream/addItem path, which
+// deserialize still uses for that format.
+void runInventoryBenchmark(size_t itemCount) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < itemCount; ++i) {
+        names.push_back("Item" + std::to_string(i));
+    }
+    Inventory inventory;
+    inventory.addItems(names);
+
+    // Average over several runs; the first one warms the caches
+    const int runs = 10;
+    auto time = [&](auto&& action) {
+        action();
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < runs; ++run) {
+            action();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / runs;
+    };
+
+    Inventory legacy;
+    double legacyTime = time([&] {
+        std::stringstream ss;
+        ss << inventory.size();
+        for (const auto& item : names) {
+            ss << " " << item;
+        }
+        legacy = Inventory();
+        legacy.deserialize(ss.str());
+    });
+
+    std::vector<char> buffer(inventory.serializedSize());
+    Inventory restored;
+    double bufferTime = time([&] {
+        size_t used = inventory.serializeInto(buffer.data(), buffer.size());
+        restored = Inventory();
+        restored.deserialize(std::string_view(buffer.data(), used));
+    });
+
+    std::cout << "Items: " << itemCount << " (restored " << legacy.size() << " / " << restored.size() << ")\n";
+    std::cout << "stringstream round trip: " << legacyTime << " ms\n";
+    std::cout << "Buffer round trip:       " << bufferTime << " ms (x" << legacyTime / bufferTime << ")\n";
+}
+
+// Kills per second: defeat reported by a thrown exception (the old combat
+// path) against the DamageOutcome result, on a resurrecting Skeleton
+void runKillBenchmark(size_t killCount) {
+    EventLog logger("", LogMode::Disabled);
+    MonsterStore store;
+    store.add(MonsterTag::Lich, "LichKing", 600, 35, 25);
+    store.add(MonsterTag::Skeleton, "Skeleton1", 40, 10, 15);
+    const size_t skeleton = 1;
+    const int damage = 30;
+    size_t kills = 0;
+
+    auto killsPerSecond = [&](auto&& kill) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < killCount; ++i) {
+            kill();
+            store.reset(skeleton, 40, 10, 15);
+        }
+        return killCount / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double thrownRate = killsPerSecond([&] {
+        try {
+            while (store.takeDamage(skeleton, damage, logger) != DamageOutcome::Defeated) {}
+            throw std::runtime_error("Health dropped below zero for " + std::string(store.name(skeleton)));
+        }
+        catch (const std::runtime_error&) {
+            ++kills;
+        }
+    });
+    double outcomeRate = killsPerSecond([&] {
+        while (store.takeDamage(skeleton, damage, logger) != DamageOutcome::Defeated) {}
+        ++kills;
+    });
+
+    std::cout << "Kills: " << kills << "\n";
+    std::cout << "Exception: " << thrownRate << " kills/sec\n";
+    std::cout << "Outcome:   " << outcomeRate << " kills/sec (x" << outcomeRate / thrownRate << ")\n";
+}
+
+// Object-per-monster layout against the column store on the combat kernels
+void runStoreBenchmark(size_t monsterCount) {
+    std::vector<std::unique_ptr<Monster>> objects;
+    MonsterStore store;
+    store.reserve(monsterCount);
+    for (size_t i = 0; i < monsterCount; ++i) {
+        // The only Lich sits at the end so both Lich checks scan everything
+        if (i + 1 == monsterCount) {
+            objects.push_back(std::make_unique<Lich>("Lich" + std::to_string(i)));
+        }
+        else {
+            objects.push_back(std::make_unique<Skeleton>("Skeleton" + std::to_string(i)));
+        }
+        store.add(*objects.back());
+    }
+    const int player_attack = 45;
+    const int rounds = 20;
+
+    auto time = [](auto&& action) {
+        auto start = std::chrono::steady_clock::now();
+        action();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    long long checksum = 0;
+    double objectTime = time([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (auto& monster : objects) {
+                checksum += std::max(0, player_attack - monster->getDefense());
+            }
+            for (auto& monster : objects) {
+                if (dynamic_cast<Skeleton*>(monster.get())) {
+                    monster = std::make_unique<Skeleton>(monster->getName(), 40, 10, 15);
+                }
+            }
+            for (const auto& monster : objects) {
+                if (dynamic_cast<Lich*>(monster.get()) && monster->getHealth() > 0) {
+                    ++checksum;
+                    break;
+                }
+            }
+        }
+    });
+    double storeTime = time([&] {
+        for (int round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i < store.size(); ++i) {
+                checksum += std::max(0, player_attack - store.defense(i));
+            }
+            for (size_t i = 0; i < store.size(); ++i) {
+                if (store.tag(i) == MonsterTag::Skeleton) {
+                    store.reset(i, 40, 10, 15);
+                }
+            }
+            checksum += store.anyAlive(MonsterTag::Lich);
+        }
+    });
+
+    std::cout << "Monsters: " << monsterCount << ", rounds: " << rounds << " (checksum " << checksum << ")\n";
+    std::cout << "Objects: " << objectTime << " ms\n";
+    std::cout << "Columns: " << storeTime << " ms (x" << objectTime / storeTime << ")\n";
+}
+
+// Default headless policy: heal below 40 HP, otherwise hit the weakest monster
+GameAction healOrHitWeakest(const Game& game) {
+    if (game.getPlayer().getHealth() < 40) {
+        return GameAction{ GameAction::Heal, 0 };
+    }
+    const MonsterStore& monsters = game.getMonsters();
+    size_t weakest = 0;
+    for (size_t i = 1; i < monsters.size(); ++i) {
+        if (monsters.health(i) < monsters.health(weakest)) weakest = i;
+    }
+    return GameAction{ GameAction::Fight, weakest };
+}
+
+// Heal below 40 HP, otherwise hit the Lich while it is alive (the Skeletons
+// it resurrects can never all be killed), then the weakest monster
+GameAction healOrHitLich(const Game& game) {
+    const MonsterStore& monsters = game.getMonsters();
+    if (game.getPlayer().getHealth() >= 40) {
+        for (size_t i = 0; i < monsters.size(); ++i) {
+            if (monsters.tag(i) == MonsterTag::Lich && monsters.health(i) > 0) {
+                return GameAction{ GameAction::Fight, i };
+            }
+        }
+    }
+    return healOrHitWeakest(game);
+}
+
+// Headless sweep over the variance the game has: combat itself is
+// deterministic, so game g gets roster g % 8 (1-4 Skeletons, with and
+// without a Lich) and every policy plays the same games. With a script only
+// the script is played.
+void runSimulation(size_t games, const std::string& script) {
+    auto setup = [](Game& game, size_t g) {
+        size_t skeletons = 1 + g % 4;
+        for (size_t i = 1; i <= skeletons; ++i) {
+            game.addMonster(MonsterTag::Skeleton, "Skeleton" + std::to_string(i));
+        }
+        if ((g / 4) % 2 == 1) {
+            game.addMonster(MonsterTag::Lich, "LichKing");
+        }
+    };
+    const size_t max_turns = 500;
+    auto report = [](const std::string& name, const BatchStats& stats) {
+        std::cout << name << ": games: " << stats.games << ", turns: " << stats.turns << " (" << stats.wasted_turns
+            << " wasted) in " << stats.seconds * 1000 << " ms\n";
+        std::cout << "  Turns/sec: " << stats.turnsPerSecond() << ", win rate: " << stats.winRate() * 100
+            << "%, average level: " << stats.averageLevel() << "\n";
+    };
+    if (!script.empty()) {
+        std::vector<GameAction> actions = parseScript(script);
+        report("Script", Game::runBatch(games, max_turns, setup, [&](const Game&, size_t turn) {
+            return actions[turn % actions.size()];
+        }));
+        return;
+    }
+    report("healOrHitWeakest", Game::runBatch(games, max_turns, setup, [](const Game& game, size_t) {
+        return healOrHitWeakest(game);
+    }));
+    report("healOrHitLich", Game::runBatch(games, max_turns, setup, [](const Game& game, size_t) {
+        return healOrHitLich(game);
+    }));
+}
+
+// Runs the world loop with `population` Skeletons and a Lich, so defeated
+// Skeletons come back and the AI phase keeps scanning the full population.
+void runWorld(size_t population, uint64_t ticks, double tickRate, const std::string& csvFile) {
+    WorldConfig config;
+    config.population = population;
+    config.spawn_per_tick = population;
+    config.ticks = ticks;
+    config.tick_rate = tickRate;
+
+    std::ofstream csv;
+    if (!csvFile.empty()) {
+        csv.open(csvFile);
+        if (!csv) {
+            throw std::runtime_error("Failed to open file for writing: " + csvFile);
+        }
+    }
+    Game game("Hero", "world.log");
+    game.addMonster(MonsterTag::Lich, "LichKing");
+    WorldMetrics metrics = game.runWorld(config, healOrHitWeakest, csvFile.empty() ? nullptr : &csv);
+
+    std::cout << "Entities: " << game.getMonsters().size() << ", ticks: " << metrics.ticks << " at " << tickRate
+        << " Hz (budget " << metrics.budget << " ms)\n";
+    std::cout << "Frame: average " << metrics.averageFrame() << " ms, max " << metrics.frame_max
+        << " ms, over budget " << metrics.overruns << " ticks\n";
+    for (int i = 0; i < WorldMetrics::PhaseCount; ++i) {
+        std::cout << "  " << WorldMetrics::phase_names[i] << ": average "
+            << (metrics.ticks ? metrics.phase_total[i] / metrics.ticks : 0) << " ms, max " << metrics.phase_max[i] << " ms\n";
+    }
+    std::cout << "AI scan: " << metrics.monsters_scanned << " monsters (" << metrics.scansPerSecond() << "/sec of AI time)\n";
+}
+
 // main
-int main() {
+int main(int argc, char* argv[]) {
+    // --simulate [games] ["script"]
+    if (argc > 1 && std::string(argv[1]) == "--simulate") {
+        try {
+            runSimulation(argc > 2 ? std::stoul(argv[2]) : 10000, argc > 3 ? argv[3] : "");
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Simulation error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // --world [entities] [ticks] [Hz] [metrics.csv]
+    if (argc > 1 && std::string(argv[1]) == "--world") {
+        try {
+            runWorld(argc > 2 ? std::stoul(argv[2]) : 1000, argc > 3 ? std::stoull(argv[3]) : 600,
+                argc > 4 ? std::stod(argv[4]) : 60, argc > 5 ? argv[5] : "");
+        }
+        catch (const std::exception& e) {
+            std::cerr << "World error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // --decode-log [file]
+    if (argc > 1 && std::string(argv[1]) == "--decode-log") {
+        std::string filename = argc > 2 ? argv[2] : "game_events.log";
+        try {
+            if (!decodeEventLog(filename, std::cout)) {
+                std::cerr << "Unable to decode event log: " << filename << "\n";
+                return 1;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Unable to decode event log " << filename << ": " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // --bench [save|store|inventory|log|kills|autosave] [count]
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        try {
+            std::string which = argc > 2 ? argv[2] : "save";
+            if (which == "store") {
+                runStoreBenchmark(argc > 3 ? std::stoul(argv[3]) : 200000);
+            }
+            else if (which == "autosave") {
+                runAutosaveBenchmark(argc > 3 ? std::stoul(argv[3]) : 100000);
+            }
+            else if (which == "kills") {
+                runKillBenchmark(argc > 3 ? std::stoul(argv[3]) : 1000000);
+            }
+            else if (which == "log") {
+                runLogBenchmark(argc > 3 ? std::stoul(argv[3]) : 1000000);
+            }
+            else if (which == "inventory") {
+                runInventoryBenchmark(argc > 3 ? std::stoul(argv[3]) : 100000);
+            }
+            else {
+                runSaveBenchmark(argc > 3 ? std::stoul(argv[3]) : 1000000);
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Benchmark error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     try {
         Game game("Hero");
-        game.addMonster(std::make_unique<Skeleton>("Skeleton1"));
-        game.addMonster(std::make_unique<Skeleton>("Skeleton2"));
-        game.addMonster(std::make_unique<Lich>("LichKing"));
+        game.addMonster(MonsterTag::Skeleton, "Skeleton1");
+        game.addMonster(MonsterTag::Skeleton, "Skeleton2");
+        game.addMonster(MonsterTag::Lich, "LichKing");
         game.play();
     }
     catch (const std::exception& e) {